@@ -7,6 +7,7 @@
 namespace Engine2D {
     class SceneManager;
     class Renderer;
+    class SpriteBatch;
     class InputManager;
     class PhysicsWorld;
     class AudioManager;
@@ -59,6 +60,12 @@ public:
      */
     Renderer* getRenderer() const;
 
+    /**
+     * @brief 获取精灵批处理器，场景渲染期间提交的精灵在场景渲染结束后统一绘制
+     * @return 精灵批处理器指针
+     */
+    SpriteBatch* getSpriteBatch() const;
+
     /**
      * @brief 获取输入管理器
      * @return 输入管理器指针
@@ -128,6 +135,7 @@ private:
     // 系统组件
     std::unique_ptr<SceneManager> m_sceneManager;
     std::unique_ptr<Renderer> m_renderer;
+    std::unique_ptr<SpriteBatch> m_spriteBatch;
     std::unique_ptr<InputManager> m_inputManager;
     std::unique_ptr<PhysicsWorld> m_physicsWorld;
     std::unique_ptr<AudioManager> m_audioManager;
@@ -237,7 +237,32 @@ public:
      */
     void updateWorldTransform();
 
+    /**
+     * @brief 检查本帧是否移动过（位置、旋转或缩放发生变化）
+     * @return 是否移动过
+     */
+    bool hasMoved() const;
+
+    /**
+     * @brief 获取本帧移动过的Transform列表
+     * 
+     * 空间索引（物理宽相、剔除结构等）只需遍历此列表即可增量更新，
+     * 每个Transform在列表中最多出现一次
+     * @return 移动过的Transform列表
+     */
+    static const std::vector<Transform*>& getMovedTransforms();
+
+    /**
+     * @brief 清空移动列表，由引擎在每帧结束时调用
+     */
+    static void clearMovedTransforms();
+
 private:
+    /**
+     * @brief 标记自身及所有子对象本帧已移动
+     */
+    void markMoved();
+
     Vector2 m_localPosition;     // 本地位置
     float m_localRotation;       // 本地旋转
     Vector2 m_localScale;        // 本地缩放
@@ -250,6 +275,9 @@ private:
     std::vector<Transform*> m_children;  // 子Transform列表
 
     bool m_dirty;                // 是否需要更新世界变换
+    bool m_moved;                // 本帧是否已加入移动列表
+
+    static std::vector<Transform*> s_movedTransforms;  // 本帧移动过的Transform列表
 };
 
 } // namespace Engine2D 
\ No newline at end of file
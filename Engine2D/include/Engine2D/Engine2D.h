@@ -14,6 +14,10 @@
 #include "Engine2D/Graphics/SpriteSheet.h"
 #include "Engine2D/Graphics/Animation.h"
 #include "Engine2D/Graphics/Camera.h"
+#include "Engine2D/Graphics/SpriteBatch.h"
+#include "Engine2D/Graphics/RenderQueue.h"
+#include "Engine2D/Graphics/SpriteRenderer.h"
+#include "Engine2D/Graphics/TextureAtlas.h"
 
 // 输入系统
 #include "Engine2D/Input/InputManager.h"
@@ -22,6 +26,7 @@
 #include "Engine2D/Physics/PhysicsWorld.h"
 #include "Engine2D/Physics/Collider.h"
 #include "Engine2D/Physics/Rigidbody.h"
+#include "Engine2D/Physics/ParticleSystem.h"
 
 // 音频系统
 #include "Engine2D/Audio/AudioManager.h"
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+#include <SDL.h>
+
+namespace Engine2D {
+
+/**
+ * @brief 渲染命令，描述一个带纹理的四边形，只包含平凡数据以便批量拷贝和排序
+ *
+ * 排序键从高位到低位依次为：层（8位）、深度（24位）、材质/混合模式（8位）、纹理（24位），
+ * 按键升序执行。纹理字段只是指针的散列，冲突只会降低合批效果，执行时以实际纹理为准
+ */
+struct RenderCommand {
+    uint64_t sortKey;           // 排序键，由makeSortKey生成
+    SDL_Texture* texture;       // 纹理
+    SDL_Rect sourceRect;        // 源矩形（像素）
+    float x;                    // 中心X（世界坐标）
+    float y;                    // 中心Y（世界坐标）
+    float halfWidth;            // 缩放后的半宽
+    float halfHeight;           // 缩放后的半高
+    float rotation;             // 旋转角度（弧度）
+    SDL_Color color;            // 颜色调制
+    SDL_BlendMode blendMode;    // 混合模式
+
+    /**
+     * @brief 生成排序键
+     * @param layer 渲染层，取值范围[-128, 127]，超出时截断
+     * @param depth 层内深度，小的先绘制
+     * @param blendMode 混合模式
+     * @param texture 纹理
+     * @return 64位排序键
+     */
+    static uint64_t makeSortKey(int layer, float depth, SDL_BlendMode blendMode, SDL_Texture* texture);
+};
+
+/**
+ * @brief 渲染命令缓冲区
+ *
+ * 组件在渲染阶段提交命令，每帧排序一次后由批处理器执行，提交与执行解耦。
+ * 提交可以在多个线程中同时进行；多线程时建议在本地攒一批后用批量版本提交，
+ * 以减少加锁次数。排序使用按字节的LSD基数排序，整批键在某一字节上都相同时跳过该趟，
+ * 排序稳定，相同键的命令保持提交顺序（不同线程之间的先后不保证）
+ */
+class RenderQueue {
+public:
+    /**
+     * @brief 构造函数
+     */
+    RenderQueue();
+    ~RenderQueue();
+
+    /**
+     * @brief 提交一条命令（线程安全）
+     * @param command 渲染命令
+     */
+    void submit(const RenderCommand& command);
+
+    /**
+     * @brief 批量提交命令（线程安全）
+     * @param commands 命令数组
+     * @param count 命令数量
+     */
+    void submit(const RenderCommand* commands, size_t count);
+
+    /**
+     * @brief 按排序键排序，之后可用getSorted()按顺序访问
+     */
+    void sort();
+
+    /**
+     * @brief 清空命令，保留已分配的内存
+     */
+    void clear();
+
+    /**
+     * @brief 获取命令数量
+     * @return 命令数量
+     */
+    size_t getCount() const;
+
+    /**
+     * @brief 获取排序后的第index条命令，须在sort()之后调用
+     * @param index 排序后的下标
+     * @return 渲染命令
+     */
+    const RenderCommand& getSorted(size_t index) const;
+
+private:
+    /**
+     * @brief 参与排序的键和命令下标
+     */
+    struct SortEntry {
+        uint64_t key;       // 排序键
+        uint32_t index;     // 命令下标
+    };
+
+    std::vector<RenderCommand> m_commands;  // 按提交顺序存放的命令
+    std::vector<SortEntry> m_entries;       // 排序结果
+    std::vector<SortEntry> m_scratch;       // 基数排序的临时缓冲区
+    mutable std::mutex m_mutex;             // 保护命令数组
+};
+
+} // namespace Engine2D
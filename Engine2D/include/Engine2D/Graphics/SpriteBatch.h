@@ -0,0 +1,212 @@
+#pragma once
+
+#include "../Core/Transform.h"
+#include "Renderer.h"
+#include "RenderQueue.h"
+#include "../Physics/DynamicTree.h"
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include <SDL.h>
+
+namespace Engine2D {
+
+class Sprite;
+class SpriteRenderer;
+
+/**
+ * @brief 精灵批处理器，把一帧内的精灵绘制合并为少量SDL_RenderGeometry调用
+ *
+ * begin()与flush()之间提交的精灵作为RenderCommand写入渲染命令缓冲区，flush()时按排序键
+ * （层、深度、混合模式、纹理）基数排序，每段连续的相同纹理与混合模式生成一次顶点批次。
+ * 使用同一图集的上千个精灵因此只需几次绘制调用。
+ * 同一层同一深度内不同纹理之间的先后顺序不保证，需要严格遮挡关系的精灵应使用不同的层或深度。
+ * draw()和submit()可在多个线程中同时调用，begin()、flush()和end()只能在渲染线程调用。
+ * begin()根据摄像机计算世界空间的视野矩形，draw()丢弃完全在视野外的精灵；
+ * SpriteRenderer组件的包围盒登记在动态包围体树中，submitVisible()只遍历与视野相交的组件。
+ * 引擎在场景渲染前后自动调用begin()和end()。立即模式的绘制不经过命令缓冲区，
+ * 粒子系统和碰撞体调试图形在绘制前会自动flush()；直接调用Renderer绘制的代码
+ * 需要在其前手动flush()，否则会被之后才提交的精灵覆盖
+ */
+class SpriteBatch {
+public:
+    /**
+     * @brief 构造函数
+     */
+    SpriteBatch();
+    ~SpriteBatch();
+
+    /**
+     * @brief 开始收集绘制命令，丢弃上一批未提交的命令
+     * @param renderer 渲染器，提供SDL渲染器和摄像机
+     */
+    void begin(Renderer* renderer);
+
+    /**
+     * @brief 更新本帧移动过的精灵渲染组件的包围盒，并提交与视野相交的组件
+     */
+    void submitVisible();
+
+    /**
+     * @brief 提交一个精灵，使用其当前源矩形
+     * @param sprite 精灵指针
+     * @param position 中心位置（世界坐标）
+     * @param rotation 旋转角度（弧度）
+     * @param scale 缩放
+     * @param color 颜色调制
+     * @param layer 渲染层，小的先绘制
+     * @param blendMode 混合模式
+     * @param depth 层内深度，小的先绘制
+     */
+    void draw(Sprite* sprite, const Vector2& position, float rotation = 0.0f,
+              const Vector2& scale = Vector2(1.0f, 1.0f), const Color& color = Color::WHITE,
+              int layer = 0, SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND, float depth = 0.0f);
+
+    /**
+     * @brief 提交纹理中的一个区域，用于精灵表帧和图集中的子图
+     * @param texture SDL纹理
+     * @param sourceRect 源矩形（像素）
+     * @param position 中心位置（世界坐标）
+     * @param rotation 旋转角度（弧度）
+     * @param scale 缩放
+     * @param color 颜色调制
+     * @param layer 渲染层，小的先绘制
+     * @param blendMode 混合模式
+     * @param depth 层内深度，小的先绘制
+     */
+    void draw(SDL_Texture* texture, const SDL_Rect& sourceRect, const Vector2& position,
+              float rotation = 0.0f, const Vector2& scale = Vector2(1.0f, 1.0f),
+              const Color& color = Color::WHITE, int layer = 0,
+              SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND, float depth = 0.0f);
+
+    /**
+     * @brief 直接提交一条已生成排序键的渲染命令
+     * @param command 渲染命令
+     */
+    void submit(const RenderCommand& command);
+
+    /**
+     * @brief 批量提交渲染命令，多线程提交时比逐条提交少加锁
+     * @param commands 命令数组
+     * @param count 命令数量
+     */
+    void submit(const RenderCommand* commands, size_t count);
+
+    /**
+     * @brief 排序并提交已收集的命令，之后可继续收集
+     */
+    void flush();
+
+    /**
+     * @brief 提交剩余命令并停止收集，之后的draw()被忽略
+     */
+    void end();
+
+    /**
+     * @brief 登记精灵渲染组件，由组件初始化时调用
+     * @param renderable 精灵渲染组件
+     */
+    void addRenderable(SpriteRenderer* renderable);
+
+    /**
+     * @brief 移除精灵渲染组件
+     * @param renderable 精灵渲染组件
+     */
+    void removeRenderable(SpriteRenderer* renderable);
+
+    /**
+     * @brief 重新计算精灵渲染组件的包围盒（精灵尺寸变化时调用，移动由Transform自动跟踪）
+     * @param renderable 精灵渲染组件
+     */
+    void updateRenderable(SpriteRenderer* renderable);
+
+    /**
+     * @brief 获取登记的精灵渲染组件数量
+     * @return 组件数量
+     */
+    int getRenderableCount() const;
+
+    /**
+     * @brief 设置是否启用视野剔除
+     * @param enabled 是否启用
+     */
+    void setCullingEnabled(bool enabled);
+
+    /**
+     * @brief 检查是否启用视野剔除
+     * @return 是否启用
+     */
+    bool isCullingEnabled() const;
+
+    /**
+     * @brief 获取本帧的世界空间视野矩形
+     * @return 视野矩形
+     */
+    const AABB& getViewBounds() const;
+
+    /**
+     * @brief 检查是否处于begin()与end()之间
+     * @return 是否正在收集
+     */
+    bool isActive() const;
+
+    /**
+     * @brief 获取待提交的命令数量
+     * @return 命令数量
+     */
+    int getPendingCount() const;
+
+    /**
+     * @brief 获取本帧提交的精灵数量（begin()时清零）
+     * @return 精灵数量
+     */
+    int getSpriteCount() const;
+
+    /**
+     * @brief 获取本帧因在视野外被剔除的精灵数量（begin()时清零）
+     * @return 剔除数量
+     */
+    int getCulledCount() const;
+
+    /**
+     * @brief 获取本帧的绘制调用次数（begin()时清零）
+     * @return 绘制调用次数
+     */
+    int getDrawCallCount() const;
+
+private:
+    /**
+     * @brief 精灵渲染组件在剔除索引中的登记信息
+     */
+    struct RenderableProxy {
+        int proxyId;                // 代理编号
+        Transform* transform;       // 登记时的Transform，移除时用于清理映射
+    };
+
+    Renderer* m_renderer;                   // 当前渲染器
+    bool m_active;                          // 是否正在收集
+    bool m_cullingEnabled;                  // 是否启用视野剔除
+    AABB m_viewBounds;                      // 本帧的世界空间视野矩形
+    int m_spriteCount;                      // 本帧提交的精灵数量
+    std::atomic<int> m_culledCount;         // 本帧剔除的精灵数量（可能多线程累加）
+    int m_drawCallCount;                    // 本帧的绘制调用次数
+
+    // 每帧复用的缓冲区
+    RenderQueue m_queue;                    // 待执行的渲染命令
+    std::vector<int> m_visibleProxies;      // 视野查询结果
+
+    // 剔除索引
+    DynamicTree m_cullingTree;                                          // 精灵渲染组件的包围盒
+    std::vector<SpriteRenderer*> m_proxyRenderables;                    // 代理编号到组件
+    std::unordered_map<SpriteRenderer*, RenderableProxy> m_renderableProxies;  // 组件到代理
+    std::unordered_map<Transform*, std::vector<SpriteRenderer*>> m_transformRenderables;  // Transform上的组件
+
+    void computeViewBounds();               // 根据摄像机计算视野矩形
+    std::vector<SDL_Vertex> m_vertices;     // 当前批次的顶点，每个精灵4个
+    std::vector<int> m_indices;             // 四边形索引，按最大批次生成
+
+    void submitBatch(SDL_Renderer* sdlRenderer, size_t begin, size_t end);  // 生成并提交排序后一段相同纹理与混合模式的命令
+};
+
+} // namespace Engine2D
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "../Core/Component.h"
+#include "../Physics/AABB.h"
+#include "Renderer.h"
+#include <SDL.h>
+
+namespace Engine2D {
+
+class Sprite;
+class SpriteBatch;
+
+/**
+ * @brief 精灵渲染组件，按游戏对象的Transform绘制一个精灵或纹理区域（如图集子图）
+ *
+ * 初始化时把世界空间包围盒登记到精灵批处理器的剔除索引中，
+ * 每帧只有与摄像机视野相交的组件才会被提交，不逐个调用render()
+ */
+class SpriteRenderer : public Component {
+public:
+    /**
+     * @brief 构造函数
+     * @param sprite 精灵指针
+     */
+    SpriteRenderer(Sprite* sprite = nullptr);
+    virtual ~SpriteRenderer() override;
+
+    /**
+     * @brief 初始化组件，登记到剔除索引
+     */
+    virtual void initialize() override;
+
+    /**
+     * @brief 销毁组件，从剔除索引移除
+     */
+    virtual void destroy() override;
+
+    /**
+     * @brief 设置精灵，替换之前设置的纹理区域，尺寸变化时更新剔除包围盒
+     * @param sprite 精灵指针
+     */
+    void setSprite(Sprite* sprite);
+
+    /**
+     * @brief 直接绘制纹理中的一个区域，替换之前设置的精灵；
+     * 使用同一图集页的组件可在批处理中合并为一次绘制调用
+     * @param texture SDL纹理（不持有）
+     * @param sourceRect 源矩形（像素）
+     */
+    void setRegion(SDL_Texture* texture, const SDL_Rect& sourceRect);
+
+    /**
+     * @brief 获取精灵
+     * @return 精灵指针
+     */
+    Sprite* getSprite() const;
+
+    /**
+     * @brief 设置颜色调制
+     * @param color 颜色
+     */
+    void setColor(const Color& color);
+
+    /**
+     * @brief 获取颜色调制
+     * @return 颜色
+     */
+    const Color& getColor() const;
+
+    /**
+     * @brief 设置渲染层，小的先绘制
+     * @param layer 渲染层
+     */
+    void setLayer(int layer);
+
+    /**
+     * @brief 获取渲染层
+     * @return 渲染层
+     */
+    int getLayer() const;
+
+    /**
+     * @brief 设置层内深度，小的先绘制
+     * @param depth 深度
+     */
+    void setDepth(float depth);
+
+    /**
+     * @brief 获取层内深度
+     * @return 深度
+     */
+    float getDepth() const;
+
+    /**
+     * @brief 设置混合模式
+     * @param blendMode 混合模式
+     */
+    void setBlendMode(SDL_BlendMode blendMode);
+
+    /**
+     * @brief 获取混合模式
+     * @return 混合模式
+     */
+    SDL_BlendMode getBlendMode() const;
+
+    /**
+     * @brief 计算精灵按当前位置、旋转和缩放绘制时的世界空间包围盒
+     * @return 包围盒
+     */
+    AABB getBounds() const;
+
+    /**
+     * @brief 把精灵提交到批处理器
+     * @param batch 精灵批处理器
+     */
+    void submit(SpriteBatch& batch) const;
+
+private:
+    Sprite* m_sprite;               // 精灵（不持有）
+    SDL_Texture* m_texture;         // 纹理区域所在的纹理（不持有，未设置精灵时使用）
+    SDL_Rect m_sourceRect;          // 纹理区域
+    Color m_color;                  // 颜色调制
+    int m_layer;                    // 渲染层
+    float m_depth;                  // 层内深度
+    SDL_BlendMode m_blendMode;      // 混合模式
+    SpriteBatch* m_batch;           // 登记的批处理器
+
+    bool getSource(SDL_Texture*& texture, SDL_Rect& sourceRect) const;  // 当前要绘制的纹理和源矩形
+};
+
+} // namespace Engine2D
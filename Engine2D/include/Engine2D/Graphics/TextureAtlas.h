@@ -0,0 +1,193 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <SDL.h>
+
+namespace Engine2D {
+
+/**
+ * @brief 天际线（Skyline）矩形装箱器
+ *
+ * 用一条由水平线段组成的天际线记录已占用区域的上边缘，插入时选择放置后顶部最低的位置
+ * （相同时选择线段更窄的），适合在加载过程中逐个插入且不需要回收空间的图集
+ */
+class AtlasPacker {
+public:
+    /**
+     * @brief 构造函数
+     * @param width 区域宽度
+     * @param height 区域高度
+     */
+    AtlasPacker(int width = 0, int height = 0);
+
+    /**
+     * @brief 清空并重设区域大小
+     * @param width 区域宽度
+     * @param height 区域高度
+     */
+    void reset(int width, int height);
+
+    /**
+     * @brief 插入一个矩形
+     * @param width 矩形宽度
+     * @param height 矩形高度
+     * @param x 输出左上角X
+     * @param y 输出左上角Y
+     * @return 是否有足够空间
+     */
+    bool insert(int width, int height, int& x, int& y);
+
+    /**
+     * @brief 把整个区域标记为已占满，之后的插入都会失败
+     */
+    void fill();
+
+private:
+    /**
+     * @brief 天际线上的一段水平线
+     */
+    struct Segment {
+        int x;          // 起点X
+        int y;          // 高度（已占用区域的下边界）
+        int width;      // 宽度
+    };
+
+    int m_width;                        // 区域宽度
+    int m_height;                       // 区域高度
+    std::vector<Segment> m_skyline;     // 从左到右的天际线
+
+    int fit(size_t index, int width, int height) const;   // 在第index段起放置时的顶部Y，放不下返回-1
+};
+
+/**
+ * @brief 图集中的一个子图
+ */
+struct AtlasRegion {
+    int page;           // 所在页
+    SDL_Rect rect;      // 在页中的像素区域
+};
+
+/**
+ * @brief 纹理图集，把大量小图合并到少数几张大纹理中
+ *
+ * 加载阶段用addImage()登记图像，pack()用天际线算法放入页中（放不下时新开一页），
+ * createTextures()上传有变化的页。之后的图像可以继续增量加入已有页。
+ * 共用纹理的精灵在批处理中可以合并为一次绘制调用。
+ * save()把各页写为BMP并生成文本描述文件，load()在运行时直接读取离线打包的结果
+ */
+class TextureAtlas {
+public:
+    /**
+     * @brief 构造函数
+     * @param pageSize 每页的边长（像素），不应超过渲染器支持的最大纹理尺寸
+     * @param padding 子图之间的间隔（像素），避免采样时相互渗色
+     */
+    TextureAtlas(int pageSize = 2048, int padding = 1);
+    ~TextureAtlas();
+
+    /**
+     * @brief 登记一张图像，像素被复制，调用者仍负责释放传入的表面
+     * @param name 子图名称，重复时失败
+     * @param surface 图像表面
+     * @return 是否成功登记
+     */
+    bool addImage(const std::string& name, SDL_Surface* surface);
+
+    /**
+     * @brief 把所有待处理的图像放入页中，按高度从大到小放置
+     * @return 是否全部放入（超过页尺寸的图像会被跳过）
+     */
+    bool pack();
+
+    /**
+     * @brief 为新增或有变化的页创建纹理
+     * @param renderer SDL渲染器
+     * @return 是否全部创建成功
+     */
+    bool createTextures(SDL_Renderer* renderer);
+
+    /**
+     * @brief 把图集写到磁盘：每页一个BMP文件，外加一个描述子图位置的文本文件
+     * @param directory 输出目录
+     * @param name 图集名称，文件名为name_页号.bmp和name.atlas
+     * @return 是否成功写入
+     */
+    bool save(const std::string& directory, const std::string& name) const;
+
+    /**
+     * @brief 读取save()生成的图集，替换当前内容并创建纹理
+     * @param renderer SDL渲染器
+     * @param filepath .atlas描述文件路径
+     * @return 是否成功读取
+     */
+    bool load(SDL_Renderer* renderer, const std::string& filepath);
+
+    /**
+     * @brief 查找子图
+     * @param name 子图名称
+     * @param region 输出子图信息
+     * @return 是否存在（未pack()的图像不存在）
+     */
+    bool getRegion(const std::string& name, AtlasRegion& region) const;
+
+    /**
+     * @brief 获取页的纹理
+     * @param page 页号
+     * @return SDL纹理，未创建时为nullptr
+     */
+    SDL_Texture* getTexture(int page) const;
+
+    /**
+     * @brief 获取页数
+     * @return 页数
+     */
+    int getPageCount() const;
+
+    /**
+     * @brief 获取子图数量
+     * @return 子图数量
+     */
+    int getRegionCount() const;
+
+    /**
+     * @brief 获取页面利用率
+     * @return 子图总面积与所有页总面积之比
+     */
+    float getOccupancy() const;
+
+    /**
+     * @brief 释放所有页、纹理和待处理的图像
+     */
+    void clear();
+
+private:
+    /**
+     * @brief 图集中的一页
+     */
+    struct Page {
+        SDL_Surface* surface;       // 页的像素（保留以便增量加入和保存）
+        SDL_Texture* texture;       // 上传后的纹理
+        AtlasPacker packer;         // 页内的装箱状态
+        bool dirty;                 // 像素在上次上传后是否有变化
+    };
+
+    /**
+     * @brief 等待放置的图像
+     */
+    struct PendingImage {
+        std::string name;           // 子图名称
+        SDL_Surface* surface;       // RGBA32格式的像素副本
+    };
+
+    int m_pageSize;                                         // 每页边长
+    int m_padding;                                          // 子图间隔
+    std::vector<Page> m_pages;                              // 所有页
+    std::vector<PendingImage> m_pending;                    // 待放置的图像
+    std::unordered_map<std::string, AtlasRegion> m_regions; // 子图名称到位置
+
+    int addPage(SDL_Surface* surface);      // 添加一页，表面为空时创建空白页，返回页号
+};
+
+} // namespace Engine2D
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../Core/Transform.h"
+#include <algorithm>
+
+namespace Engine2D {
+
+/**
+ * @brief 轴对齐包围盒，供宽相检测和区域查询使用
+ */
+struct AABB {
+    Vector2 min;    // 左下角坐标
+    Vector2 max;    // 右上角坐标
+
+    AABB() {}
+    AABB(const Vector2& min, const Vector2& max) : min(min), max(max) {}
+
+    // 是否与另一个包围盒重叠
+    bool overlaps(const AABB& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y;
+    }
+
+    // 是否完全包含另一个包围盒
+    bool contains(const AABB& other) const {
+        return min.x <= other.min.x && min.y <= other.min.y &&
+               max.x >= other.max.x && max.y >= other.max.y;
+    }
+
+    // 是否包含某个点
+    bool contains(const Vector2& point) const {
+        return point.x >= min.x && point.x <= max.x &&
+               point.y >= min.y && point.y <= max.y;
+    }
+
+    // 合并两个包围盒
+    static AABB merge(const AABB& a, const AABB& b) {
+        return AABB(Vector2(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y)),
+                    Vector2(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y)));
+    }
+
+    // 向四周扩展指定距离
+    AABB expanded(float margin) const {
+        return AABB(Vector2(min.x - margin, min.y - margin),
+                    Vector2(max.x + margin, max.y + margin));
+    }
+
+    // 周长（用于包围体树的代价估计）
+    float perimeter() const {
+        return 2.0f * ((max.x - min.x) + (max.y - min.y));
+    }
+
+    // 中心点
+    Vector2 center() const {
+        return Vector2((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f);
+    }
+};
+
+} // namespace Engine2D
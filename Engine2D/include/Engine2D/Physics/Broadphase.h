@@ -0,0 +1,123 @@
+#pragma once
+
+#include "AABB.h"
+#include <vector>
+#include <functional>
+
+namespace Engine2D {
+
+class Collider;
+
+/**
+ * @brief 宽相检测输出的候选碰撞对
+ */
+struct BroadphasePair {
+    Collider* colliderA;    // 第一个碰撞体
+    Collider* colliderB;    // 第二个碰撞体
+    int subShape;           // 碰撞体B的子形状下标（瓦片地图中的矩形），-1表示整个碰撞体
+
+    BroadphasePair() : colliderA(nullptr), colliderB(nullptr), subShape(-1) {}
+    BroadphasePair(Collider* a, Collider* b, int subShape = -1) : colliderA(a), colliderB(b), subShape(subShape) {}
+};
+
+/**
+ * @brief 宽相射线检测回调
+ *
+ * 参数为候选碰撞体，返回值为新的最大检测距离（返回更小的值可裁剪后续遍历，返回负数则终止）
+ */
+using BroadphaseRaycastCallback = std::function<float(Collider*)>;
+
+/**
+ * @brief 宽相类型枚举
+ */
+enum class BroadphaseType {
+    SPATIAL_HASH,   // 均匀网格空间哈希，适合尺寸相近的物体
+    DYNAMIC_TREE,   // 动态包围体树，适合尺寸差异大的物体
+    SWEEP_AND_PRUNE // 排序扫描，适合运动连贯的物体
+};
+
+/**
+ * @brief 宽相检测基类，管理碰撞体代理并输出候选碰撞对
+ */
+class Broadphase {
+public:
+    virtual ~Broadphase() = default;
+
+    /**
+     * @brief 获取宽相类型
+     * @return 宽相类型
+     */
+    virtual BroadphaseType getType() const = 0;
+
+    /**
+     * @brief 创建代理
+     * @param aabb 包围盒
+     * @param collider 关联的碰撞体
+     * @return 代理ID
+     */
+    virtual int createProxy(const AABB& aabb, Collider* collider) = 0;
+
+    /**
+     * @brief 销毁代理
+     * @param proxyId 代理ID
+     */
+    virtual void destroyProxy(int proxyId) = 0;
+
+    /**
+     * @brief 移动代理
+     * @param proxyId 代理ID
+     * @param aabb 新包围盒
+     * @return 代理在宽相结构中的位置是否发生变化
+     */
+    virtual bool moveProxy(int proxyId, const AABB& aabb) = 0;
+
+    /**
+     * @brief 获取代理登记的包围盒
+     * @param proxyId 代理ID
+     * @return 包围盒
+     */
+    virtual const AABB& getAABB(int proxyId) const = 0;
+
+    /**
+     * @brief 获取代理关联的碰撞体
+     * @param proxyId 代理ID
+     * @return 碰撞体指针
+     */
+    virtual Collider* getCollider(int proxyId) const = 0;
+
+    /**
+     * @brief 计算所有包围盒重叠的候选碰撞对
+     * @param pairs 输出缓冲区，会先被清空，容量保留以便复用
+     */
+    virtual void computePairs(std::vector<BroadphasePair>& pairs) const = 0;
+
+    /**
+     * @brief 查询与指定区域重叠的碰撞体
+     * @param aabb 查询区域
+     * @param results 输出列表（追加写入，不会清空）
+     */
+    virtual void query(const AABB& aabb, std::vector<Collider*>& results) const = 0;
+
+    /**
+     * @brief 沿射线遍历可能相交的碰撞体
+     * @param origin 射线起点
+     * @param direction 射线方向（单位向量）
+     * @param maxDistance 最大检测距离
+     * @param callback 候选碰撞体回调
+     */
+    virtual void raycast(const Vector2& origin, const Vector2& direction, float maxDistance,
+                         const BroadphaseRaycastCallback& callback) const = 0;
+
+    /**
+     * @brief 获取代理数量
+     * @return 代理数量
+     */
+    virtual int getProxyCount() const = 0;
+
+    /**
+     * @brief 清空所有代理
+     */
+    virtual void clear() = 0;
+};
+
+} // namespace Engine2D
@@ -2,8 +2,10 @@
 
 #include "../Core/Component.h"
 #include "../Core/Transform.h"
+#include "Narrowphase.h"
+#include <algorithm>
+#include <cstdint>
 #include <vector>
-#include <functional>
 
 namespace Engine2D {
 
@@ -16,7 +18,8 @@ struct CollisionInfo;
 enum class ColliderType {
     BOX,      // 矩形碰撞体
     CIRCLE,   // 圆形碰撞体
-    POLYGON   // 多边形碰撞体
+    POLYGON,  // 多边形碰撞体
+    TILEMAP   // 瓦片地图碰撞体
 };
 
 /**
@@ -134,70 +137,11 @@ public:
      */
     Rigidbody* getRigidbody() const;
 
-    /**
-     * @brief 设置碰撞回调
-     * @param callback 碰撞开始回调
-     */
-    void setOnCollisionEnter(std::function<void(Collider*)> callback);
-
-    /**
-     * @brief 设置碰撞持续回调
-     * @param callback 碰撞持续回调
-     */
-    void setOnCollisionStay(std::function<void(Collider*)> callback);
-
-    /**
-     * @brief 设置碰撞结束回调
-     * @param callback 碰撞结束回调
-     */
-    void setOnCollisionExit(std::function<void(Collider*)> callback);
-
-    /**
-     * @brief 设置触发器进入回调
-     * @param callback 触发器进入回调
-     */
-    void setOnTriggerEnter(std::function<void(Collider*)> callback);
-
-    /**
-     * @brief 设置触发器持续回调
-     * @param callback 触发器持续回调
-     */
-    void setOnTriggerStay(std::function<void(Collider*)> callback);
-
-    /**
-     * @brief 设置触发器退出回调
-     * @param callback 触发器退出回调
-     */
-    void setOnTriggerExit(std::function<void(Collider*)> callback);
-
-    /**
-     * @brief 处理碰撞事件
-     * @param other 另一个碰撞体
-     * @param isEntering 是否刚开始碰撞
-     */
-    void handleCollision(Collider* other, bool isEntering);
-
-    /**
-     * @brief 处理触发器事件
-     * @param other 另一个碰撞体
-     * @param isEntering 是否刚进入触发器
-     */
-    void handleTrigger(Collider* other, bool isEntering);
-
 private:
     Vector2 m_offset;                          // 相对于游戏对象的偏移位置
     bool m_isTrigger;                          // 是否为触发器
     int m_layer;                               // 碰撞层
     uint32_t m_collisionMask;                  // 碰撞掩码
-    std::vector<Collider*> m_collidingWith;    // 当前正在碰撞的碰撞体列表
-
-    // 回调函数
-    std::function<void(Collider*)> m_onCollisionEnter;
-    std::function<void(Collider*)> m_onCollisionStay;
-    std::function<void(Collider*)> m_onCollisionExit;
-    std::function<void(Collider*)> m_onTriggerEnter;
-    std::function<void(Collider*)> m_onTriggerStay;
-    std::function<void(Collider*)> m_onTriggerExit;
 };
 
 /**
@@ -329,4 +273,318 @@ private:
     float m_radius;  // 半径
 };
 
-} // namespace Engine2D 
\ No newline at end of file
+/**
+ * @brief 凸多边形碰撞体
+ *
+ * 顶点以Transform位置为原点给出，设置时取凸包并按逆时针排列，边法线预先计算。
+ * 世界坐标下的顶点和法线缓存在碰撞体中，Transform变化后才重新计算，
+ * 窄相与射线检测的支撑点查询都直接读取缓存
+ */
+class PolygonCollider : public Collider {
+public:
+    /**
+     * @brief 构造函数，默认为1x1的正方形
+     */
+    PolygonCollider();
+
+    /**
+     * @brief 构造函数
+     * @param vertices 本地坐标下的顶点
+     */
+    explicit PolygonCollider(const std::vector<Vector2>& vertices);
+    virtual ~PolygonCollider() override;
+
+    /**
+     * @brief 获取碰撞体类型
+     * @return 多边形碰撞体类型
+     */
+    virtual ColliderType getType() const override;
+
+    /**
+     * @brief 设置顶点，取凸包后保存
+     * @param vertices 本地坐标下的顶点
+     * @return 是否设置成功，凸包少于3个顶点或超过PolygonShape::MAX_VERTICES时失败
+     */
+    bool setVertices(const std::vector<Vector2>& vertices);
+
+    /**
+     * @brief 设置为以原点为中心的矩形
+     * @param width 宽度
+     * @param height 高度
+     */
+    void setAsBox(float width, float height);
+
+    /**
+     * @brief 获取本地坐标下的顶点（逆时针）
+     * @return 顶点数组
+     */
+    const std::vector<Vector2>& getVertices() const;
+
+    /**
+     * @brief 获取本地坐标下的边法线
+     * @return 法线数组，法线i对应顶点i到顶点i+1的边
+     */
+    const std::vector<Vector2>& getNormals() const;
+
+    /**
+     * @brief 获取世界坐标下的多边形，Transform变化后才重新计算
+     *
+     * 物理世界在同步Transform时刷新缓存，并行窄相中只读
+     * @return 世界坐标下的多边形
+     */
+    const PolygonShape& getWorldShape() const;
+
+    /**
+     * @brief 计算绕Transform原点的转动惯量
+     * @param mass 质量
+     * @return 转动惯量
+     */
+    float computeInertia(float mass) const;
+
+    /**
+     * @brief 获取包围盒
+     * @param min 左下角坐标
+     * @param max 右上角坐标
+     */
+    virtual void getBoundingBox(Vector2& min, Vector2& max) const override;
+
+    /**
+     * @brief 检查是否与另一个碰撞体碰撞
+     * @param other 另一个碰撞体
+     * @param info 碰撞信息输出
+     * @return 是否碰撞
+     */
+    virtual bool checkCollision(Collider* other, CollisionInfo& info) const override;
+
+    /**
+     * @brief 绘制碰撞体（调试用）
+     */
+    virtual void debugDraw() const override;
+
+private:
+    std::vector<Vector2> m_vertices;        // 本地顶点
+    std::vector<Vector2> m_normals;         // 本地边法线
+    mutable PolygonShape m_worldShape;      // 世界坐标缓存
+    mutable Vector2 m_cachedPosition;       // 缓存对应的位置
+    mutable Vector2 m_cachedScale;          // 缓存对应的缩放
+    mutable float m_cachedRotation;         // 缓存对应的旋转
+    mutable bool m_worldShapeValid;         // 缓存是否有效
+};
+
+/**
+ * @brief 瓦片地图碰撞体
+ *
+ * 保存一张实心标记网格，实心格子被贪心合并为尽量大的矩形：先沿行向右延伸，再整段向下延伸。
+ * 每个格子记录覆盖它的矩形下标，宽相与区域查询直接按格子查表，射线检测沿网格逐格前进。
+ * 物理世界中整张地图只占一个静态代理，与动态物体接触时每个矩形作为一个子形状单独求解。
+ * 格子(0, 0)的左上角位于碰撞体中心（Transform位置加偏移），忽略Transform的旋转和缩放；
+ * 瓦片地图总是静态的
+ */
+class TilemapCollider : public Collider {
+public:
+    /**
+     * @brief 合并后的矩形，以格子为单位
+     */
+    struct TileRect {
+        int x;          // 左上角格子列
+        int y;          // 左上角格子行
+        int width;      // 宽度（格子数）
+        int height;     // 高度（格子数）
+    };
+
+    /**
+     * @brief 构造函数，所有格子初始为空
+     * @param width 列数
+     * @param height 行数
+     * @param tileSize 格子边长
+     */
+    TilemapCollider(int width = 0, int height = 0, float tileSize = 32.0f);
+    virtual ~TilemapCollider() override;
+
+    /**
+     * @brief 更新碰撞体，格子被修改过时重新合并矩形
+     * @param deltaTime 帧间隔时间
+     */
+    virtual void update(float deltaTime) override;
+
+    /**
+     * @brief 获取碰撞体类型
+     * @return 瓦片地图碰撞体类型
+     */
+    virtual ColliderType getType() const override;
+
+    /**
+     * @brief 设置整张地图并立即重新合并矩形
+     * @param width 列数
+     * @param height 行数
+     * @param solid 按行排列的实心标记，非0为实心，长度不足的部分视为空
+     */
+    void setTiles(int width, int height, const std::vector<uint8_t>& solid);
+
+    /**
+     * @brief 设置单个格子，合并结果在下一次update或调用rebuild()时更新
+     * @param x 列
+     * @param y 行
+     * @param solid 是否实心
+     */
+    void setTile(int x, int y, bool solid);
+
+    /**
+     * @brief 检查格子是否实心
+     * @param x 列
+     * @param y 行
+     * @return 是否实心，超出范围时返回false
+     */
+    bool isSolid(int x, int y) const;
+
+    /**
+     * @brief 获取列数
+     * @return 列数
+     */
+    int getWidth() const;
+
+    /**
+     * @brief 获取行数
+     * @return 行数
+     */
+    int getHeight() const;
+
+    /**
+     * @brief 设置格子边长
+     * @param tileSize 格子边长
+     */
+    void setTileSize(float tileSize);
+
+    /**
+     * @brief 获取格子边长
+     * @return 格子边长
+     */
+    float getTileSize() const;
+
+    /**
+     * @brief 立即重新合并矩形，并通知物理世界更新包围盒
+     */
+    void rebuild();
+
+    /**
+     * @brief 获取合并后的矩形数量
+     * @return 矩形数量
+     */
+    int getRectCount() const;
+
+    /**
+     * @brief 获取合并后的矩形
+     * @param index 矩形下标
+     * @return 以格子为单位的矩形
+     */
+    const TileRect& getRect(int index) const;
+
+    /**
+     * @brief 获取矩形在世界坐标下的包围盒
+     * @param index 矩形下标
+     * @return 包围盒
+     */
+    AABB getRectBounds(int index) const;
+
+    /**
+     * @brief 生成矩形的窄相形状
+     * @param index 矩形下标
+     * @param shape 输出的轴对齐矩形
+     */
+    void buildRectShape(int index, ColliderShape& shape) const;
+
+    /**
+     * @brief 把世界坐标转换为格子坐标
+     * @param point 世界坐标
+     * @param x 输出的列
+     * @param y 输出的行
+     * @return 是否位于地图范围内
+     */
+    bool worldToTile(const Vector2& point, int& x, int& y) const;
+
+    /**
+     * @brief 遍历与区域重叠的矩形，每个矩形只访问一次
+     *
+     * 只查看区域覆盖的格子，不分配内存，可在多个线程中同时调用
+     * @param area 世界坐标下的区域
+     * @param function 以矩形下标为参数的回调
+     */
+    template <typename Function>
+    void forEachRect(const AABB& area, Function function) const;
+
+    /**
+     * @brief 射线检测，沿网格逐格前进直到进入实心格子
+     * @param origin 射线起点
+     * @param direction 单位方向
+     * @param maxDistance 最大距离
+     * @param distance 输出的命中距离，起点在实心格子内时为0
+     * @param normal 输出的命中表面法线，起点在实心格子内时为零向量
+     * @return 是否命中
+     */
+    bool raycast(const Vector2& origin, const Vector2& direction, float maxDistance,
+                 float& distance, Vector2& normal) const;
+
+    /**
+     * @brief 检查点是否位于实心格子内
+     * @param point 世界坐标
+     * @return 是否位于实心格子内
+     */
+    bool containsPoint(const Vector2& point) const;
+
+    /**
+     * @brief 获取整张地图的包围盒
+     * @param min 左下角坐标
+     * @param max 右上角坐标
+     */
+    virtual void getBoundingBox(Vector2& min, Vector2& max) const override;
+
+    /**
+     * @brief 检查是否与另一个碰撞体碰撞，取穿透最深的矩形
+     * @param other 另一个碰撞体
+     * @param info 碰撞信息输出
+     * @return 是否碰撞
+     */
+    virtual bool checkCollision(Collider* other, CollisionInfo& info) const override;
+
+    /**
+     * @brief 绘制合并后的矩形（调试用）
+     */
+    virtual void debugDraw() const override;
+
+private:
+    std::vector<uint8_t> m_tiles;       // 实心标记，按行排列
+    std::vector<int> m_cellRects;       // 每个格子所属的矩形下标，空格子为-1
+    std::vector<TileRect> m_rects;      // 合并后的矩形
+    int m_width;                        // 列数
+    int m_height;                       // 行数
+    float m_tileSize;                   // 格子边长
+    bool m_dirty;                       // 格子修改后尚未重新合并
+
+    void mergeRects();                  // 贪心合并实心格子
+    bool getTileRange(const AABB& area, int& minX, int& minY, int& maxX, int& maxY) const;  // 区域覆盖的格子范围
+};
+
+template <typename Function>
+void TilemapCollider::forEachRect(const AABB& area, Function function) const {
+    int minX, minY, maxX, maxY;
+    if (!getTileRange(area, minX, minY, maxX, maxY)) {
+        return;
+    }
+
+    for (int y = minY; y <= maxY; ++y) {
+        const int* row = m_cellRects.data() + y * m_width;
+        for (int x = minX; x <= maxX; ++x) {
+            const int index = row[x];
+            if (index < 0) {
+                continue;
+            }
+            // 矩形只在它与查询范围交集的左上角格子处访问
+            const TileRect& rect = m_rects[index];
+            if (x == std::max(rect.x, minX) && y == std::max(rect.y, minY)) {
+                function(index);
+            }
+        }
+    }
+}
+
+} // namespace Engine2D
\ No newline at end of file
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Broadphase.h"
+#include <vector>
+
+namespace Engine2D {
+
+/**
+ * @brief 动态包围体树，用于宽相检测和空间查询
+ *
+ * 叶节点保存扩展后的包围盒（胖包围盒），物体在胖包围盒内移动时无需更新树结构。
+ * 插入时按周长代价选择兄弟节点，并通过旋转保持树的平衡
+ */
+class DynamicTree : public Broadphase {
+public:
+    /**
+     * @brief 构造函数
+     * @param margin 胖包围盒的扩展距离
+     */
+    explicit DynamicTree(float margin = 4.0f);
+    virtual ~DynamicTree() override;
+
+    /**
+     * @brief 获取宽相类型
+     * @return 动态树类型
+     */
+    virtual BroadphaseType getType() const override;
+
+    /**
+     * @brief 设置胖包围盒的扩展距离，只对之后插入或移动的代理生效
+     * @param margin 扩展距离
+     */
+    void setMargin(float margin);
+
+    /**
+     * @brief 获取胖包围盒的扩展距离
+     * @return 扩展距离
+     */
+    float getMargin() const;
+
+    /**
+     * @brief 创建代理
+     * @param aabb 包围盒
+     * @param collider 关联的碰撞体
+     * @return 代理ID
+     */
+    virtual int createProxy(const AABB& aabb, Collider* collider) override;
+
+    /**
+     * @brief 销毁代理
+     * @param proxyId 代理ID
+     */
+    virtual void destroyProxy(int proxyId) override;
+
+    /**
+     * @brief 移动代理
+     * @param proxyId 代理ID
+     * @param aabb 新包围盒
+     * @return 是否超出原胖包围盒而重新插入
+     */
+    virtual bool moveProxy(int proxyId, const AABB& aabb) override;
+
+    /**
+     * @brief 获取代理的胖包围盒
+     * @param proxyId 代理ID
+     * @return 胖包围盒
+     */
+    virtual const AABB& getAABB(int proxyId) const override;
+
+    /**
+     * @brief 获取代理关联的碰撞体
+     * @param proxyId 代理ID
+     * @return 碰撞体指针
+     */
+    virtual Collider* getCollider(int proxyId) const override;
+
+    /**
+     * @brief 计算所有胖包围盒重叠的候选碰撞对
+     * @param pairs 输出缓冲区，会先被清空，容量保留以便复用
+     */
+    virtual void computePairs(std::vector<BroadphasePair>& pairs) const override;
+
+    /**
+     * @brief 查询与指定区域重叠的碰撞体
+     * @param aabb 查询区域
+     * @param results 输出列表（追加写入，不会清空）
+     */
+    virtual void query(const AABB& aabb, std::vector<Collider*>& results) const override;
+
+    /**
+     * @brief 查询与指定区域重叠的代理编号，用于不关联碰撞体的代理（如渲染剔除）
+     * @param aabb 查询区域
+     * @param results 输出列表（追加写入，不会清空）
+     */
+    void queryProxies(const AABB& aabb, std::vector<int>& results) const;
+
+    /**
+     * @brief 沿射线遍历可能相交的碰撞体，回调返回的距离会裁剪后续遍历
+     * @param origin 射线起点
+     * @param direction 射线方向（单位向量）
+     * @param maxDistance 最大检测距离
+     * @param callback 候选碰撞体回调
+     */
+    virtual void raycast(const Vector2& origin, const Vector2& direction, float maxDistance,
+                         const BroadphaseRaycastCallback& callback) const override;
+
+    /**
+     * @brief 获取代理数量
+     * @return 代理数量
+     */
+    virtual int getProxyCount() const override;
+
+    /**
+     * @brief 清空所有节点
+     */
+    virtual void clear() override;
+
+    /**
+     * @brief 获取树高度（调试用）
+     * @return 树高度，空树为0
+     */
+    int getHeight() const;
+
+private:
+    static const int NULL_NODE = -1;
+
+    struct Node {
+        AABB aabb;              // 胖包围盒（内部节点为子节点的合并包围盒）
+        Collider* collider;     // 关联的碰撞体（仅叶节点）
+        int parent;             // 父节点（空闲时作为空闲链表的下一项）
+        int child1;             // 左子节点
+        int child2;             // 右子节点
+        int height;             // 叶节点为0，空闲节点为-1
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    float m_margin;                  // 胖包围盒扩展距离
+    std::vector<Node> m_nodes;       // 节点池
+    int m_root;                      // 根节点
+    int m_freeList;                  // 空闲节点链表头
+    int m_proxyCount;                // 叶节点数量
+    mutable std::vector<int> m_stack;  // 遍历用栈（复用以避免分配）
+
+    // 私有辅助方法
+    int allocateNode();
+    void freeNode(int nodeId);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int nodeId);
+};
+
+} // namespace Engine2D
@@ -0,0 +1,286 @@
+#pragma once
+
+#include "../Core/Transform.h"
+#include "AABB.h"
+
+namespace Engine2D {
+
+class Collider;
+class TilemapCollider;
+enum class ColliderType;
+
+/**
+ * @brief 世界坐标下的凸多边形
+ *
+ * 顶点按逆时针排列，边i为顶点i到顶点i+1，法线在构造时一次算好，
+ * 分离轴检测和射线检测直接使用，不再逐次求边和归一化
+ */
+struct PolygonShape {
+    static const int MAX_VERTICES = 8;
+
+    Vector2 vertices[MAX_VERTICES];   // 顶点
+    Vector2 normals[MAX_VERTICES];    // 各边的单位外法线
+    Vector2 centroid;                 // 质心
+    int count;                        // 顶点数量
+
+    PolygonShape() : count(0) {}
+
+    /**
+     * @brief 获取包围盒
+     * @return 包含所有顶点的包围盒
+     */
+    AABB getAABB() const;
+
+    /**
+     * @brief 获取沿指定方向最远的顶点（支撑点）
+     * @param direction 方向
+     * @return 顶点下标
+     */
+    int getSupport(const Vector2& direction) const;
+};
+
+/**
+ * @brief 世界坐标下的圆
+ */
+struct CircleShape {
+    Vector2 center;     // 圆心
+    float radius;       // 半径
+
+    CircleShape() : radius(0.0f) {}
+};
+
+/**
+ * @brief 世界坐标下的矩形，可带旋转
+ */
+struct BoxShape {
+    Vector2 center;         // 中心
+    Vector2 halfExtents;    // 半宽与半高
+    float rotation;         // 旋转角度（弧度）
+
+    BoxShape() : rotation(0.0f) {}
+};
+
+/**
+ * @brief 窄相使用的紧凑形状数据
+ *
+ * 在窄相之前从碰撞体中一次性提取，检测循环只读这些数据，不再调用碰撞体的虚函数。
+ * 多边形较大，只保存指向碰撞体世界坐标缓存的指针；瓦片地图只保存碰撞体指针，
+ * 射线与形状投射按网格查询其中的矩形
+ */
+struct ColliderShape {
+    ColliderType type;              // 形状类型
+    CircleShape circle;             // 圆形数据
+    BoxShape box;                   // 矩形数据
+    const PolygonShape* polygon;    // 多边形数据
+    const TilemapCollider* tilemap; // 瓦片地图数据
+
+    ColliderShape() : type(), polygon(nullptr), tilemap(nullptr) {}
+};
+
+/**
+ * @brief 窄相检测结果，最多两个接触点
+ */
+struct ContactPoints {
+    static const int MAX_POINTS = 2;
+
+    Vector2 normal;                     // 从A指向B的碰撞法线
+    Vector2 points[MAX_POINTS];         // 世界坐标下的接触点
+    float penetrations[MAX_POINTS];     // 各接触点的穿透深度
+    int ids[MAX_POINTS];                // 接触特征编号，用于跨帧匹配热启动冲量
+    int pointCount;                     // 接触点数量
+
+    ContactPoints() : pointCount(0) {}
+};
+
+/**
+ * @brief 构造有向矩形
+ * @param center 中心
+ * @param halfWidth 半宽
+ * @param halfHeight 半高
+ * @param rotation 旋转角度（弧度）
+ * @param shape 输出的多边形
+ */
+void makeBoxShape(const Vector2& center, float halfWidth, float halfHeight, float rotation, PolygonShape& shape);
+
+/**
+ * @brief 把矩形转换为多边形
+ * @param box 矩形
+ * @param shape 输出的多边形
+ */
+void makeBoxShape(const BoxShape& box, PolygonShape& shape);
+
+/**
+ * @brief 把本地坐标下的多边形变换到世界坐标
+ *
+ * 法线按缩放的逆转置变换，非均匀缩放下也保持垂直于边
+ * @param localVertices 本地顶点
+ * @param localNormals 本地边法线
+ * @param count 顶点数量
+ * @param position 平移
+ * @param rotation 旋转角度（弧度）
+ * @param scale 缩放
+ * @param shape 输出的多边形
+ */
+void transformPolygon(const Vector2* localVertices, const Vector2* localNormals, int count,
+                      const Vector2& position, float rotation, const Vector2& scale, PolygonShape& shape);
+
+/**
+ * @brief 单调链算法求凸包，结果按逆时针排列并去掉共线点
+ * @param points 输入点，会被原地排序
+ * @param count 输入点数量
+ * @param hull 输出顶点，容量至少为2*count
+ * @return 凸包顶点数量
+ */
+int computeConvexHull(Vector2* points, int count, Vector2* hull);
+
+/**
+ * @brief 检查碰撞体是否为带旋转的矩形，需要走多边形窄相
+ * @param collider 碰撞体
+ * @return 是否为有向矩形
+ */
+bool isOrientedBox(const Collider* collider);
+
+/**
+ * @brief 从碰撞体生成世界坐标下的窄相形状
+ * @param collider 碰撞体
+ * @param shape 输出的形状
+ */
+void buildColliderShape(const Collider* collider, ColliderShape& shape);
+
+/**
+ * @brief 两个轴对齐矩形的碰撞检测，接触点取重叠区间的两端
+ * @param a 矩形A（忽略旋转）
+ * @param b 矩形B（忽略旋转）
+ * @param contact 输出的接触信息
+ * @return 是否重叠
+ */
+bool collideAlignedBoxes(const BoxShape& a, const BoxShape& b, ContactPoints& contact);
+
+/**
+ * @brief 两个凸多边形的分离轴检测，重叠时用参考边裁剪入射边得到接触点
+ * @param a 多边形A
+ * @param b 多边形B
+ * @param contact 输出的接触信息
+ * @return 是否重叠
+ */
+bool collidePolygons(const PolygonShape& a, const PolygonShape& b, ContactPoints& contact);
+
+/**
+ * @brief 凸多边形与圆的碰撞检测
+ * @param a 多边形A
+ * @param b 圆B
+ * @param contact 输出的接触信息
+ * @return 是否重叠
+ */
+bool collidePolygonCircle(const PolygonShape& a, const CircleShape& b, ContactPoints& contact);
+
+/**
+ * @brief 两个圆的碰撞检测
+ * @param a 圆A
+ * @param b 圆B
+ * @param contact 输出的接触信息
+ * @return 是否重叠
+ */
+bool collideCircles(const CircleShape& a, const CircleShape& b, ContactPoints& contact);
+
+/**
+ * @brief 射线与凸多边形求交
+ * @param shape 多边形
+ * @param origin 射线起点
+ * @param direction 单位方向
+ * @param maxDistance 最大距离
+ * @param distance 输出的命中距离，起点在内部时为0
+ * @param normal 输出的命中表面法线，起点在内部时为零向量
+ * @return 是否命中
+ */
+bool raycastPolygon(const PolygonShape& shape, const Vector2& origin, const Vector2& direction,
+                    float maxDistance, float& distance, Vector2& normal);
+
+/**
+ * @brief 射线与圆求交
+ * @param shape 圆
+ * @param origin 射线起点
+ * @param direction 单位方向
+ * @param maxDistance 最大距离
+ * @param distance 输出的命中距离，起点在内部时为0
+ * @param normal 输出的命中表面法线
+ * @return 是否命中
+ */
+bool raycastCircle(const CircleShape& shape, const Vector2& origin, const Vector2& direction,
+                   float maxDistance, float& distance, Vector2& normal);
+
+/**
+ * @brief 射线与圆角凸多边形（凸多边形向外膨胀radius）求交
+ *
+ * 只有一个顶点时退化为圆。用于形状投射：被投射形状与目标的闵可夫斯基和
+ * 就是一个圆角凸多边形，投射即为从投射形状中心发出的射线
+ * @param vertices 逆时针顶点
+ * @param count 顶点数量
+ * @param radius 圆角半径
+ * @param origin 射线起点
+ * @param direction 单位方向
+ * @param maxDistance 最大距离
+ * @param distance 输出的命中距离，起点在内部时为0
+ * @param normal 输出的命中表面法线，起点在内部时为零向量
+ * @return 是否命中
+ */
+bool raycastRoundedPolygon(const Vector2* vertices, int count, float radius, const Vector2& origin,
+                           const Vector2& direction, float maxDistance, float& distance, Vector2& normal);
+
+/**
+ * @brief 圆沿射线投射到窄相形状
+ * @param shape 目标形状
+ * @param radius 投射圆的半径
+ * @param origin 圆心起点
+ * @param direction 单位方向
+ * @param maxDistance 最大距离
+ * @param distance 输出的命中距离
+ * @param normal 输出的命中表面法线
+ * @return 是否命中
+ */
+bool circleCastShape(const ColliderShape& shape, float radius, const Vector2& origin, const Vector2& direction,
+                     float maxDistance, float& distance, Vector2& normal);
+
+/**
+ * @brief 轴对齐矩形沿射线投射到窄相形状
+ * @param shape 目标形状
+ * @param halfExtents 投射矩形的半宽与半高
+ * @param origin 矩形中心起点
+ * @param direction 单位方向
+ * @param maxDistance 最大距离
+ * @param distance 输出的命中距离
+ * @param normal 输出的命中表面法线
+ * @return 是否命中
+ */
+bool boxCastShape(const ColliderShape& shape, const Vector2& halfExtents, const Vector2& origin,
+                  const Vector2& direction, float maxDistance, float& distance, Vector2& normal);
+
+/**
+ * @brief 检查点是否在窄相形状内（含边界）
+ * @param shape 形状
+ * @param point 点
+ * @return 是否包含
+ */
+bool containsPoint(const ColliderShape& shape, const Vector2& point);
+
+/**
+ * @brief 获取窄相形状的包围盒
+ * @param shape 形状
+ * @return 包围盒
+ */
+AABB computeShapeAABB(const ColliderShape& shape);
+
+/**
+ * @brief 射线与任意窄相形状求交
+ * @param shape 形状
+ * @param origin 射线起点
+ * @param direction 单位方向
+ * @param maxDistance 最大距离
+ * @param distance 输出的命中距离
+ * @param normal 输出的命中表面法线
+ * @return 是否命中
+ */
+bool raycastShape(const ColliderShape& shape, const Vector2& origin, const Vector2& direction,
+                  float maxDistance, float& distance, Vector2& normal);
+
+} // namespace Engine2D
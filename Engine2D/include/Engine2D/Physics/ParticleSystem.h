@@ -0,0 +1,265 @@
+#pragma once
+
+#include "../Core/Component.h"
+#include "../Core/Transform.h"
+#include "../Graphics/Renderer.h"
+#include "AABB.h"
+#include "Narrowphase.h"
+#include <vector>
+#include <random>
+#include <cstdint>
+
+namespace Engine2D {
+
+class Collider;
+class Sprite;
+
+/**
+ * @brief 粒子发射器参数
+ *
+ * 偏移和方向都相对于粒子系统所在游戏对象的Transform，随其旋转
+ */
+struct ParticleEmitterConfig {
+    Vector2 offset;         // 发射位置相对游戏对象的偏移
+    float rate;             // 每秒持续发射的数量，0表示只通过emit()爆发
+    float minLifetime;      // 最短寿命（秒）
+    float maxLifetime;      // 最长寿命（秒）
+    float minSpeed;         // 最小初速度
+    float maxSpeed;         // 最大初速度
+    float direction;        // 发射方向（弧度）
+    float spread;           // 发射方向的随机张角（弧度，总宽度）
+    float startSize;        // 出生时的边长
+    float endSize;          // 消亡时的边长
+    Color startColor;       // 出生时的颜色
+    Color endColor;         // 消亡时的颜色
+
+    ParticleEmitterConfig()
+        : rate(50.0f), minLifetime(1.0f), maxLifetime(2.0f), minSpeed(50.0f), maxSpeed(100.0f)
+        , direction(-1.5707963f), spread(0.5f), startSize(4.0f), endSize(1.0f)
+        , startColor(Color::WHITE), endColor(255, 255, 255, 0) {}
+};
+
+/**
+ * @brief 粒子系统组件，用于碎屑、火花等大量短命的小物体
+ *
+ * 粒子不创建游戏对象和刚体，状态按属性分别存放在预分配的连续数组中，
+ * 积分循环没有分支，可被编译器自动向量化；容量不变时每帧不分配内存。
+ * 重力取自物理世界，可选地与静态碰撞体碰撞（粒子视为点，沿本帧位移做射线检测）。
+ * 渲染时所有粒子合并为一次SDL_RenderGeometry调用
+ */
+class ParticleSystem : public Component {
+public:
+    /**
+     * @brief 构造函数
+     * @param maxParticles 最大粒子数量
+     */
+    ParticleSystem(int maxParticles = 10000);
+    virtual ~ParticleSystem() override;
+
+    /**
+     * @brief 更新粒子：积分、碰撞、回收过期粒子并按发射速率生成新粒子
+     * @param deltaTime 帧间隔时间
+     */
+    virtual void update(float deltaTime) override;
+
+    /**
+     * @brief 批量渲染所有粒子
+     */
+    virtual void render() override;
+
+    /**
+     * @brief 添加发射器
+     * @param config 发射器参数
+     * @return 发射器下标
+     */
+    int addEmitter(const ParticleEmitterConfig& config);
+
+    /**
+     * @brief 获取发射器参数，可直接修改
+     * @param index 发射器下标
+     * @return 发射器参数
+     */
+    ParticleEmitterConfig& getEmitter(int index);
+
+    /**
+     * @brief 获取发射器数量
+     * @return 发射器数量
+     */
+    int getEmitterCount() const;
+
+    /**
+     * @brief 启用或暂停发射器的持续发射，已发射的粒子不受影响
+     * @param index 发射器下标
+     * @param enabled 是否启用
+     */
+    void setEmitterEnabled(int index, bool enabled);
+
+    /**
+     * @brief 从指定发射器立即发射一批粒子
+     * @param index 发射器下标
+     * @param count 数量
+     * @return 实际发射的数量，受容量限制
+     */
+    int emit(int index, int count);
+
+    /**
+     * @brief 清除所有粒子
+     */
+    void clear();
+
+    /**
+     * @brief 设置最大粒子数量，超出新容量的粒子被丢弃
+     * @param maxParticles 最大粒子数量
+     */
+    void setMaxParticles(int maxParticles);
+
+    /**
+     * @brief 获取最大粒子数量
+     * @return 最大粒子数量
+     */
+    int getMaxParticles() const;
+
+    /**
+     * @brief 获取当前粒子数量
+     * @return 粒子数量
+     */
+    int getParticleCount() const;
+
+    /**
+     * @brief 设置重力缩放
+     * @param scale 重力缩放
+     */
+    void setGravityScale(float scale);
+
+    /**
+     * @brief 获取重力缩放
+     * @return 重力缩放
+     */
+    float getGravityScale() const;
+
+    /**
+     * @brief 设置线性阻尼
+     * @param drag 线性阻尼
+     */
+    void setDrag(float drag);
+
+    /**
+     * @brief 获取线性阻尼
+     * @return 线性阻尼
+     */
+    float getDrag() const;
+
+    /**
+     * @brief 设置是否与静态碰撞体碰撞
+     * @param enabled 是否碰撞
+     */
+    void setCollisionEnabled(bool enabled);
+
+    /**
+     * @brief 检查是否与静态碰撞体碰撞
+     * @return 是否碰撞
+     */
+    bool isCollisionEnabled() const;
+
+    /**
+     * @brief 设置参与碰撞的静态碰撞层掩码
+     * @param mask 层掩码
+     */
+    void setCollisionLayerMask(uint32_t mask);
+
+    /**
+     * @brief 获取参与碰撞的静态碰撞层掩码
+     * @return 层掩码
+     */
+    uint32_t getCollisionLayerMask() const;
+
+    /**
+     * @brief 设置碰撞弹性系数
+     * @param restitution 弹性系数
+     */
+    void setRestitution(float restitution);
+
+    /**
+     * @brief 获取碰撞弹性系数
+     * @return 弹性系数
+     */
+    float getRestitution() const;
+
+    /**
+     * @brief 设置粒子贴图，为空时绘制纯色方块
+     * @param sprite 精灵指针
+     */
+    void setSprite(Sprite* sprite);
+
+    /**
+     * @brief 获取粒子贴图
+     * @return 精灵指针
+     */
+    Sprite* getSprite() const;
+
+    /**
+     * @brief 设置混合模式
+     * @param blendMode 混合模式
+     */
+    void setBlendMode(SDL_BlendMode blendMode);
+
+    /**
+     * @brief 获取混合模式
+     * @return 混合模式
+     */
+    SDL_BlendMode getBlendMode() const;
+
+private:
+    struct Emitter {
+        ParticleEmitterConfig config;   // 参数
+        float accumulator;              // 未满一个粒子的发射量
+        bool enabled;                   // 是否持续发射
+    };
+
+    /**
+     * @brief 粒子状态数组（SoA），按容量预分配，前count个有效
+     */
+    struct Particles {
+        std::vector<float> positionsX;      // 位置X
+        std::vector<float> positionsY;      // 位置Y
+        std::vector<float> velocitiesX;     // 速度X
+        std::vector<float> velocitiesY;     // 速度Y
+        std::vector<float> ages;            // 已存活时间
+        std::vector<float> lifetimes;       // 寿命
+        std::vector<uint16_t> emitters;     // 所属发射器下标
+        int count;                          // 有效粒子数量
+
+        Particles() : count(0) {}
+        void resize(int capacity);          // 调整容量
+    };
+
+    Particles m_particles;                  // 粒子状态
+    std::vector<Emitter> m_emitters;        // 发射器
+    int m_maxParticles;                     // 最大粒子数量
+    float m_gravityScale;                   // 重力缩放
+    float m_drag;                           // 线性阻尼
+    bool m_collisionEnabled;                // 是否与静态碰撞体碰撞
+    uint32_t m_collisionLayerMask;          // 参与碰撞的静态碰撞层
+    float m_restitution;                    // 碰撞弹性系数
+    Sprite* m_sprite;                       // 粒子贴图（可为空）
+    SDL_BlendMode m_blendMode;              // 混合模式
+    std::mt19937 m_random;                  // 随机数生成器
+
+    // 每帧复用的缓冲区
+    std::vector<Collider*> m_staticColliders;   // 与粒子包围盒重叠的静态碰撞体
+    std::vector<ColliderShape> m_staticShapes;  // 静态碰撞体的形状数据
+    std::vector<AABB> m_staticBounds;           // 静态碰撞体的包围盒
+    std::vector<int> m_staticCellRanges;        // 每个静态形状覆盖的网格单元范围（minX, minY, maxX, maxY）
+    std::vector<int> m_cellStarts;              // 每个网格单元在m_cellShapes中的起始位置，末尾多一个
+    std::vector<int> m_cellShapes;              // 按单元排列的静态形状下标
+    std::vector<SDL_Vertex> m_vertices;         // 渲染顶点，每个粒子4个
+    std::vector<int> m_indices;                 // 渲染索引，每个粒子6个，按容量一次生成
+
+    void integrate(float deltaTime, const Vector2& gravity);  // 积分速度和位置
+    void collideStatic(float deltaTime);        // 与静态碰撞体做射线检测并反弹
+    void removeExpired();                       // 压缩数组，移除寿命耗尽的粒子
+    int spawn(int emitterIndex, int count);     // 在发射器处生成粒子
+    float randomRange(float min, float max);    // 均匀随机数
+};
+
+} // namespace Engine2D
@@ -3,12 +3,17 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <unordered_map>
+#include <cstdint>
 #include "../Core/Transform.h"
+#include "Broadphase.h"
+#include "Narrowphase.h"
 
 namespace Engine2D {
 
 class Collider;
 class Rigidbody;
+class ThreadPool;
 
 /**
  * @brief 碰撞信息结构体
@@ -23,16 +28,200 @@ struct CollisionInfo {
     CollisionInfo() : colliderA(nullptr), colliderB(nullptr), penetration(0.0f) {}
 };
 
+/**
+ * @brief 接触流形中的单个接触点
+ */
+struct ManifoldPoint {
+    Vector2 position;           // 世界坐标下的接触点
+    Vector2 offsetA;            // 接触点相对刚体A中心的偏移
+    Vector2 offsetB;            // 接触点相对刚体B中心的偏移
+    float penetration;          // 穿透深度
+    float normalImpulse;        // 累积法向冲量
+    float tangentImpulse;       // 累积切向冲量
+    float normalMass;           // 法向有效质量
+    float tangentMass;          // 切向有效质量
+    float velocityBias;         // 弹性产生的目标分离速度
+    int id;                     // 特征编号，用于帧间匹配接触点
+
+    ManifoldPoint()
+        : penetration(0.0f), normalImpulse(0.0f), tangentImpulse(0.0f)
+        , normalMass(0.0f), tangentMass(0.0f), velocityBias(0.0f), id(0) {}
+};
+
+/**
+ * @brief 持久接触流形，按碰撞体对跨帧保存累积冲量用于热启动
+ *
+ * 碰撞体对按指针顺序规范化，法线从A指向B
+ */
+struct ContactManifold {
+    static const int MAX_POINTS = 2;
+
+    Collider* colliderA;        // 第一个碰撞体
+    Collider* colliderB;        // 第二个碰撞体
+    int subShape;               // 瓦片地图一侧的矩形下标，与碰撞体对一起作为缓存键，-1表示整个碰撞体
+    uint64_t pairKey;           // 两侧碰撞体登记序号组成的排序键，A的序号较小
+    Rigidbody* bodyA;           // 第一个刚体（可为空）
+    Rigidbody* bodyB;           // 第二个刚体（可为空）
+    int indexA;                 // 刚体A在物理世界状态数组中的下标（无刚体为-1）
+    int indexB;                 // 刚体B在物理世界状态数组中的下标（无刚体为-1）
+    Vector2 normal;             // 碰撞法线
+    float friction;             // 混合摩擦系数
+    float restitution;          // 混合弹性系数
+    int pointCount;             // 接触点数量，0表示不参与求解（如触发器）
+    ManifoldPoint points[MAX_POINTS];  // 接触点
+    float normalMatrix[3];      // 两点法向约束的耦合矩阵 (k11, k12, k22)
+    float normalMatrixInverse[3];  // 耦合矩阵的逆 (k11, k12, k22)
+
+    ContactManifold()
+        : colliderA(nullptr), colliderB(nullptr), subShape(-1), pairKey(0), bodyA(nullptr), bodyB(nullptr)
+        , indexA(-1), indexB(-1), friction(0.0f), restitution(0.0f), pointCount(0)
+        , normalMatrix{ 0.0f, 0.0f, 0.0f }, normalMatrixInverse{ 0.0f, 0.0f, 0.0f } {}
+};
+
+/**
+ * @brief 批量射线/形状投射中的一条射线
+ */
+struct Ray {
+    Vector2 origin;         // 起点
+    Vector2 direction;      // 方向（无需归一化）
+    float maxDistance;      // 最大检测距离
+    uint32_t layerMask;     // 可命中的碰撞层掩码
+
+    Ray() : maxDistance(0.0f), layerMask(0xFFFFFFFFu) {}
+    Ray(const Vector2& origin, const Vector2& direction, float maxDistance, uint32_t layerMask = 0xFFFFFFFFu)
+        : origin(origin), direction(direction), maxDistance(maxDistance), layerMask(layerMask) {}
+};
+
+/**
+ * @brief 批量射线/形状投射的命中结果
+ */
+struct RaycastHit {
+    Collider* collider;     // 命中的碰撞体，未命中时为空
+    Vector2 point;          // 射线为命中点；形状投射为撞击时投射形状的中心
+    Vector2 normal;         // 命中表面法线，起点已在内部时为零向量
+    float distance;         // 沿射线方向的距离
+    int rayIndex;           // 对应的射线下标
+
+    RaycastHit() : collider(nullptr), distance(0.0f), rayIndex(-1) {}
+};
+
+/**
+ * @brief 批量投射的结果模式
+ */
+enum class RaycastMode {
+    CLOSEST,    // 每条射线只保留最近的命中，结果与射线一一对应
+    ALL         // 保留所有命中，按射线分组、组内按距离排序
+};
+
+/**
+ * @brief 碰撞/触发器事件
+ */
+struct ContactEvent {
+    Collider* colliderA;    // 第一个碰撞体
+    Collider* colliderB;    // 第二个碰撞体
+    int contactIndex;       // 对应getContacts()中的下标，退出事件为-1
+
+    ContactEvent() : colliderA(nullptr), colliderB(nullptr), contactIndex(-1) {}
+    ContactEvent(Collider* a, Collider* b, int index) : colliderA(a), colliderB(b), contactIndex(index) {}
+};
+
+/**
+ * @brief 一步内产生的全部碰撞/触发器事件，按类型分组存放
+ *
+ * 任一碰撞体为触发器的接触产生触发器事件，否则产生碰撞事件。
+ * 两侧都休眠的接触不产生持续事件，也不会因休眠而退出。数组在每步复用，内容保留到下一步开始
+ */
+struct ContactEvents {
+    std::vector<ContactEvent> collisionEnter;   // 本步开始接触
+    std::vector<ContactEvent> collisionStay;    // 上一步和本步都接触
+    std::vector<ContactEvent> collisionExit;    // 上一步接触而本步分离
+    std::vector<ContactEvent> triggerEnter;     // 本步进入触发器
+    std::vector<ContactEvent> triggerStay;      // 持续位于触发器内
+    std::vector<ContactEvent> triggerExit;      // 本步离开触发器
+
+    void clear();                               // 清空所有事件，保留容量
+};
+
+/**
+ * @brief 物理步统计数据，每步开始时重置
+ *
+ * 各阶段耗时同时以"Physics::<阶段名>"为名记录到Profiler
+ */
+struct PhysicsStats {
+    int bodyCount;                  // 刚体数量
+    int awakeBodyCount;             // 本步参与移动的刚体数量（活动、醒着且非静态）
+    int pairCount;                  // 宽相产生的碰撞对数量（层剔除之后）
+    int layerCulledPairs;           // 被层碰撞矩阵剔除的碰撞对数量（动态-静态部分只在记录性能数据时统计）
+    int narrowphaseTests;           // 通过过滤、执行了窄相检测的碰撞对数量
+    int contactCount;               // 接触数量
+    int islandCount;                // 参与求解的岛数量
+    int solverIterations;           // 每个岛使用的求解迭代次数（没有需要求解的接触时为0）
+    float integrateForcesTime;      // 积分力耗时（毫秒）
+    float detectCollisionsTime;     // 碰撞检测耗时（毫秒），包含宽相、窄相和构建接触岛
+    float resolveCollisionsTime;    // 求解接触耗时（毫秒）
+    float integrateVelocitiesTime;  // 积分速度耗时（毫秒），包含连续碰撞检测
+    float stepTime;                 // 整步耗时（毫秒），包含写回Transform和休眠，不含事件回调
+
+    PhysicsStats()
+        : bodyCount(0), awakeBodyCount(0), pairCount(0), layerCulledPairs(0), narrowphaseTests(0)
+        , contactCount(0), islandCount(0), solverIterations(0), integrateForcesTime(0.0f)
+        , detectCollisionsTime(0.0f), resolveCollisionsTime(0.0f), integrateVelocitiesTime(0.0f), stepTime(0.0f) {}
+};
+
+/**
+ * @brief 物理世界的状态快照，用于回滚
+ *
+ * 只包含平凡可复制的数组，刚体状态按刚体在世界中的下标排列，保存和恢复都是整段复制。
+ * 快照可以反复复用，容量足够后保存不再分配内存。刚体的质量、类型等属性属于配置，不在快照中；
+ * 快照只能恢复到刚体和碰撞体集合与保存时相同的世界
+ */
+struct PhysicsSnapshot {
+    std::vector<Rigidbody*> rigidbodies;        // 保存时的刚体顺序，恢复时用于校验
+    std::vector<Vector2> positions;             // 位置
+    std::vector<float> rotations;               // 旋转（弧度）
+    std::vector<Vector2> velocities;            // 线速度
+    std::vector<float> angularVelocities;       // 角速度
+    std::vector<Vector2> forces;                // 累积的力
+    std::vector<float> torques;                 // 累积的扭矩
+    std::vector<float> sleepTimers;             // 静止时间
+    std::vector<int> sleepLinks;                // 休眠岛的环形链表
+    std::vector<uint8_t> asleep;                // 是否休眠
+    std::vector<ContactManifold> manifolds;     // 接触流形缓存（热启动冲量）
+    std::vector<BroadphasePair> contactPairs;   // 上一步接触的碰撞对（用于生成事件）
+    std::vector<char> contactTriggers;          // 各碰撞对是否为触发器接触
+    std::vector<int> contactSlots;              // 碰撞对集合的哈希槽
+
+    /**
+     * @brief 获取快照数据占用的字节数
+     * @return 字节数
+     */
+    size_t getByteSize() const;
+};
+
 /**
  * @brief 碰撞回调函数类型
  */
 using CollisionCallback = std::function<void(const CollisionInfo&)>;
 
+/**
+ * @brief 事件回调函数类型，每步派发事件后调用一次
+ */
+using ContactEventCallback = std::function<void(const ContactEvents&)>;
+
+/**
+ * @brief 窄相检测函数类型，按两侧的形状类型从函数表中选取
+ */
+using NarrowphaseFunction = bool (*)(const ColliderShape& shapeA, const ColliderShape& shapeB, ContactPoints& contact);
+
 /**
  * @brief 物理世界类，负责模拟和处理物理
  */
 class PhysicsWorld {
+    friend class Rigidbody;
+
 public:
+    static const int LAYER_COUNT = 32;      // 碰撞层数量，层编号为0~31
+
     /**
      * @brief 构造函数
      */
@@ -96,10 +285,26 @@ public:
 
     /**
      * @brief 设置碰撞回调
+     *
+     * 在整步完成后对每个接触调用，回调中可以添加或移除刚体
      * @param callback 碰撞回调函数
      */
     void setCollisionCallback(const CollisionCallback& callback);
 
+    /**
+     * @brief 设置事件回调
+     *
+     * 每步完成后以整批事件调用一次，取代逐个碰撞体的回调，回调中可以添加或移除刚体
+     * @param callback 事件回调函数
+     */
+    void setContactEventCallback(const ContactEventCallback& callback);
+
+    /**
+     * @brief 获取最近一步产生的碰撞/触发器事件
+     * @return 按类型分组的事件数组
+     */
+    const ContactEvents& getContactEvents() const;
+
     /**
      * @brief 检查两个碰撞体是否碰撞
      * @param colliderA 第一个碰撞体
@@ -109,6 +314,17 @@ public:
      */
     bool checkCollision(Collider* colliderA, Collider* colliderB, CollisionInfo& info);
 
+    /**
+     * @brief 按形状类型查表执行窄相检测
+     *
+     * 一侧为瓦片地图时逐个检测与另一侧包围盒重叠的矩形，返回穿透最深的结果
+     * @param shapeA 形状A
+     * @param shapeB 形状B
+     * @param contact 接触信息输出，法线从A指向B
+     * @return 是否碰撞
+     */
+    static bool collideShapes(const ColliderShape& shapeA, const ColliderShape& shapeB, ContactPoints& contact);
+
     /**
      * @brief 执行射线检测
      * @param origin 射线起点
@@ -119,6 +335,40 @@ public:
      */
     bool raycast(const Vector2& origin, const Vector2& direction, float maxDistance, CollisionInfo& hitInfo);
 
+    /**
+     * @brief 批量射线检测
+     *
+     * 射线按线段中点的空间位置分组，每组只遍历一次宽相，候选只与组内的射线测试；
+     * 候选碰撞体的包围盒按结构数组排列，射线与包围盒的测试一次处理多个候选（支持SSE时使用SIMD）。触发器不会被命中
+     * @param rays 射线列表
+     * @param hits 输出列表，CLOSEST模式下与rays一一对应（未命中的collider为空），ALL模式下只包含命中
+     * @param mode 结果模式
+     * @return 命中数量
+     */
+    int raycastBatch(const std::vector<Ray>& rays, std::vector<RaycastHit>& hits, RaycastMode mode = RaycastMode::CLOSEST);
+
+    /**
+     * @brief 批量圆形投射，沿射线移动半径为radius的圆
+     * @param rays 射线列表，起点为圆心
+     * @param radius 圆的半径
+     * @param hits 输出列表，含义同raycastBatch
+     * @param mode 结果模式
+     * @return 命中数量
+     */
+    int circleCastBatch(const std::vector<Ray>& rays, float radius, std::vector<RaycastHit>& hits,
+                        RaycastMode mode = RaycastMode::CLOSEST);
+
+    /**
+     * @brief 批量矩形投射，沿射线移动轴对齐矩形
+     * @param rays 射线列表，起点为矩形中心
+     * @param halfExtents 矩形的半宽与半高
+     * @param hits 输出列表，含义同raycastBatch
+     * @param mode 结果模式
+     * @return 命中数量
+     */
+    int boxCastBatch(const std::vector<Ray>& rays, const Vector2& halfExtents, std::vector<RaycastHit>& hits,
+                     RaycastMode mode = RaycastMode::CLOSEST);
+
     /**
      * @brief 启用或禁用物理世界
      * @param enabled 是否启用
@@ -131,18 +381,430 @@ public:
      */
     bool isEnabled() const;
 
+    /**
+     * @brief 设置宽相检测后端，会将现有碰撞体迁移到新后端
+     * @param type 宽相类型
+     */
+    void setBroadphaseType(BroadphaseType type);
+
+    /**
+     * @brief 获取宽相检测后端类型
+     * @return 宽相类型
+     */
+    BroadphaseType getBroadphaseType() const;
+
+    /**
+     * @brief 设置宽相空间哈希的网格单元大小
+     * @param cellSize 网格单元大小，建议略大于常见物体尺寸
+     */
+    void setBroadphaseCellSize(float cellSize);
+
+    /**
+     * @brief 获取宽相空间哈希的网格单元大小
+     * @return 网格单元大小
+     */
+    float getBroadphaseCellSize() const;
+
+    /**
+     * @brief 设置动态树胖包围盒的扩展距离
+     * @param margin 扩展距离
+     */
+    void setBroadphaseMargin(float margin);
+
+    /**
+     * @brief 获取动态树胖包围盒的扩展距离
+     * @return 扩展距离
+     */
+    float getBroadphaseMargin() const;
+
+    /**
+     * @brief 重新评估碰撞体的静态/动态分区并重新计算其包围盒
+     *
+     * 静态碰撞体（无刚体或刚体为STATIC）单独保存在很少重建的加速结构中，
+     * 移动静态物体、修改碰撞体尺寸或刚体类型后需调用此方法
+     * @param collider 碰撞体指针
+     */
+    void updateCollider(Collider* collider);
+
+    /**
+     * @brief 获取静态碰撞体数量
+     * @return 静态碰撞体数量
+     */
+    int getStaticColliderCount() const;
+
+    /**
+     * @brief 设置两个碰撞层之间是否碰撞
+     *
+     * 层碰撞矩阵在生成碰撞对时全局生效：静态碰撞体按层分桶，动态碰撞体只查询可碰撞的层；
+     * 动态碰撞体之间的碰撞对在进入窄相之前按矩阵剔除。碰撞体自身的碰撞掩码仍然同时生效。
+     * 注意所有动态碰撞体共用一个宽相，不可碰撞的动态层之间的碰撞对仍会由宽相生成，
+     * 剔除只省去窄相；大量互不碰撞的动态层重叠在一起时（例如成群的子弹），宽相开销不会因矩阵而减少。
+     * 超出0~31的层号按第0层处理
+     * @param layerA 第一个层
+     * @param layerB 第二个层
+     * @param collide 是否碰撞
+     */
+    void setLayerCollision(int layerA, int layerB, bool collide);
+
+    /**
+     * @brief 检查两个碰撞层之间是否碰撞
+     * @param layerA 第一个层
+     * @param layerB 第二个层
+     * @return 是否碰撞
+     */
+    bool getLayerCollision(int layerA, int layerB) const;
+
+    /**
+     * @brief 获取与指定层碰撞的所有层
+     * @param layer 碰撞层
+     * @return 层掩码，第i位表示是否与第i层碰撞
+     */
+    uint32_t getLayerCollisionMask(int layer) const;
+
+    /**
+     * @brief 启用或禁用自动休眠
+     * @param enabled 是否启用
+     */
+    void setSleepingEnabled(bool enabled);
+
+    /**
+     * @brief 检查是否启用自动休眠
+     * @return 是否启用
+     */
+    bool isSleepingEnabled() const;
+
+    /**
+     * @brief 设置休眠速度阈值，速度持续低于阈值的刚体开始累计休眠时间
+     * @param linearThreshold 线速度阈值
+     * @param angularThreshold 角速度阈值（弧度/秒）
+     */
+    void setSleepThresholds(float linearThreshold, float angularThreshold);
+
+    /**
+     * @brief 设置进入休眠所需的静止时间
+     * @param seconds 静止时间（秒）
+     */
+    void setTimeToSleep(float seconds);
+
+    /**
+     * @brief 获取进入休眠所需的静止时间
+     * @return 静止时间（秒）
+     */
+    float getTimeToSleep() const;
+
+    /**
+     * @brief 唤醒刚体及与其同属一个休眠岛的所有刚体
+     * @param rigidbody 刚体指针
+     */
+    void wakeIsland(Rigidbody* rigidbody);
+
+    /**
+     * @brief 设置物理求解使用的工作线程数量
+     *
+     * 窄相检测按碰撞对并行，接触求解按岛并行，结果与线程数无关
+     * @param threadCount 工作线程数量，0表示在调用线程串行执行（默认）
+     */
+    void setThreadCount(int threadCount);
+
+    /**
+     * @brief 获取物理求解使用的工作线程数量
+     * @return 工作线程数量
+     */
+    int getThreadCount() const;
+
+    /**
+     * @brief 查询包围盒与指定区域重叠的碰撞体
+     * @param area 查询区域
+     * @param results 输出列表，会先被清空
+     * @return 找到的碰撞体数量
+     */
+    int queryAABB(const AABB& area, std::vector<Collider*>& results);
+
+    /**
+     * @brief 查询包围盒与区域重叠的静态碰撞体
+     *
+     * 只遍历层掩码选中的静态层桶，供粒子等不参与刚体模拟的系统做静态碰撞
+     * @param area 查询区域
+     * @param results 输出列表（会先清空）
+     * @param layerMask 参与查询的碰撞层掩码
+     * @return 结果数量
+     */
+    int queryStaticAABB(const AABB& area, std::vector<Collider*>& results, uint32_t layerMask = 0xFFFFFFFFu);
+
+    /**
+     * @brief 查询与矩形区域重叠的碰撞体
+     *
+     * 经宽相筛选后按实际形状精确检测，结果写入调用方提供的缓冲区，不分配内存。
+     * 触发器也会被查询到，未激活的碰撞体会被忽略
+     * @param center 矩形中心
+     * @param halfExtents 半宽与半高
+     * @param rotation 旋转角度（弧度）
+     * @param results 输出缓冲区
+     * @param maxResults 缓冲区容量，超出的结果被丢弃
+     * @param layerMask 参与查询的碰撞层掩码
+     * @return 写入的碰撞体数量
+     */
+    int overlapBox(const Vector2& center, const Vector2& halfExtents, float rotation,
+                   Collider** results, int maxResults, uint32_t layerMask = 0xFFFFFFFFu);
+
+    /**
+     * @brief 查询与圆形区域重叠的碰撞体
+     * @param center 圆心
+     * @param radius 半径
+     * @param results 输出缓冲区
+     * @param maxResults 缓冲区容量，超出的结果被丢弃
+     * @param layerMask 参与查询的碰撞层掩码
+     * @return 写入的碰撞体数量
+     */
+    int overlapCircle(const Vector2& center, float radius, Collider** results, int maxResults,
+                      uint32_t layerMask = 0xFFFFFFFFu);
+
+    /**
+     * @brief 查询包含指定点的碰撞体
+     * @param point 查询点
+     * @param results 输出缓冲区
+     * @param maxResults 缓冲区容量，超出的结果被丢弃
+     * @param layerMask 参与查询的碰撞层掩码
+     * @return 写入的碰撞体数量
+     */
+    int queryPoint(const Vector2& point, Collider** results, int maxResults, uint32_t layerMask = 0xFFFFFFFFu);
+
+    /**
+     * @brief 根据Transform移动列表增量更新宽相代理
+     *
+     * 每次更新前会自动调用；引擎在每帧清空移动列表前也会调用一次，
+     * 以便捕获物理更新之后由游戏逻辑移动的物体
+     */
+    void syncTransforms();
+
+    /**
+     * @brief 获取最近一次宽相检测产生的候选碰撞对
+     * @return 候选碰撞对列表
+     */
+    const std::vector<BroadphasePair>& getBroadphasePairs() const;
+
+    /**
+     * @brief 获取最近一次检测到的接触列表
+     * @return 接触列表
+     */
+    const std::vector<CollisionInfo>& getContacts() const;
+
+    /**
+     * @brief 获取最近一次求解的接触流形，与getContacts()按下标一一对应
+     * @return 接触流形列表
+     */
+    const std::vector<ContactManifold>& getManifolds() const;
+
+    /**
+     * @brief 获取最近一步的统计数据
+     * @return 统计数据
+     */
+    const PhysicsStats& getStats() const;
+
+    /**
+     * @brief 保存刚体运动状态、接触缓存和休眠状态
+     *
+     * 先同步被游戏逻辑移动过的Transform，之后只做整段复制，快照容量足够时不分配内存
+     * @param snapshot 输出的快照，原有内容被覆盖
+     */
+    void saveState(PhysicsSnapshot& snapshot);
+
+    /**
+     * @brief 恢复saveState保存的状态
+     *
+     * 刚体的Transform同时被写回，位置或旋转变化的碰撞体在恢复时更新宽相代理；
+     * 本步的接触列表与事件被清空
+     * @param snapshot 快照
+     * @return 是否恢复成功，刚体集合或顺序与保存时不同时失败
+     */
+    bool restoreState(const PhysicsSnapshot& snapshot);
+
+    /**
+     * @brief 设置是否把各阶段耗时记录到Profiler
+     *
+     * 关闭后也不再统计被层碰撞矩阵剔除的动态-静态碰撞对
+     * @param enabled 是否记录
+     */
+    void setProfilingEnabled(bool enabled);
+
+    /**
+     * @brief 检查是否把各阶段耗时记录到Profiler
+     * @return 是否记录
+     */
+    bool isProfilingEnabled() const;
+
 private:
+    static const int SHAPE_TYPE_COUNT = 3;   // 形状类型数量，对应ColliderType
+    static const NarrowphaseFunction s_narrowphaseTable[SHAPE_TYPE_COUNT][SHAPE_TYPE_COUNT];  // 窄相函数表
+
     std::vector<Rigidbody*> m_rigidbodies;   // 刚体列表
     std::vector<Collider*> m_colliders;      // 碰撞体列表
     Vector2 m_gravity;                        // 重力
     bool m_enabled;                           // 是否启用
     CollisionCallback m_collisionCallback;    // 碰撞回调
+    ContactEventCallback m_contactEventCallback;  // 事件回调
+    int m_iterations;                         // 当前步的求解迭代次数
+
+    struct ProxyHandle {
+        int proxyId;        // 宽相代理ID
+        bool isStatic;      // 是否位于静态分区
+        int layer;          // 静态碰撞体所在的层桶
+        uint32_t id;        // 碰撞体的登记序号，决定碰撞对和求解顺序，迁移分区时保持不变
+    };
+
+    /**
+     * @brief 带排序键的碰撞对
+     */
+    struct KeyedPair {
+        uint64_t key;           // 两侧碰撞体登记序号组成的排序键
+        BroadphasePair pair;    // 碰撞对
+    };
+
+    std::unique_ptr<Broadphase> m_broadphase;                        // 动态碰撞体的宽相后端
+    std::unique_ptr<Broadphase> m_staticBuckets[LAYER_COUNT];        // 按层分桶的静态碰撞体加速结构（按需创建）
+    uint32_t m_staticLayers;                                         // 非空静态层桶的掩码
+    uint32_t m_layerMatrix[LAYER_COUNT];                             // 层碰撞矩阵，第i行为与第i层碰撞的层掩码
+    bool m_layerMatrixFull;                                          // 矩阵是否全部允许碰撞（此时跳过剔除）
+    PhysicsStats m_stats;                                            // 最近一步的统计数据
+    bool m_profilingEnabled;                                         // 是否把各阶段耗时记录到Profiler
+    std::vector<Collider*> m_dynamicColliders;                       // 动态分区的碰撞体
+    float m_broadphaseCellSize;                                      // 空间哈希网格单元大小
+    float m_broadphaseMargin;                                        // 动态树胖包围盒扩展距离
+    std::unordered_map<Collider*, ProxyHandle> m_proxyIds;           // 碰撞体 -> 宽相代理
+    std::unordered_map<Transform*, std::vector<Collider*>> m_transformColliders;  // Transform -> 碰撞体列表
+    std::vector<BroadphasePair> m_pairBuffer;                        // 候选碰撞对缓冲区（每步复用）
+    std::vector<KeyedPair> m_keyedPairs;                             // 动态碰撞对的排序缓冲区（每步复用）
+    uint32_t m_nextColliderId;                                       // 下一个登记的碰撞体的序号
+    std::vector<Collider*> m_queryBuffer;                            // 静态分区查询缓冲区（每步复用）
+    std::vector<CollisionInfo> m_contacts;                           // 本步接触列表
+
+    /**
+     * @brief 接触碰撞对的哈希集合，按插入顺序保存碰撞对，开放寻址槽只存下标
+     *
+     * 碰撞对按指针顺序规范化后作为键，清空时保留容量，稳定后每步不再分配内存
+     */
+    struct ContactPairSet {
+        std::vector<BroadphasePair> pairs;    // 碰撞对（按插入顺序）
+        std::vector<char> triggers;           // 各碰撞对是否为触发器接触
+        std::vector<int> slots;               // 哈希槽，保存pairs下标，-1为空
+
+        int size() const { return static_cast<int>(pairs.size()); }
+        int find(Collider* a, Collider* b) const;       // 查找碰撞对，不存在时为-1
+        void insert(Collider* a, Collider* b, bool trigger);  // 插入碰撞对（调用方保证不重复）
+        void remove(const Collider* collider);          // 删除含指定碰撞体的碰撞对
+        void clear();                                   // 清空，保留容量
+        void rehash(size_t slotCount);                  // 按新的槽数重建哈希槽
+    };
+
+    ContactPairSet m_previousPairs;                                  // 上一步接触的碰撞对
+    ContactPairSet m_currentPairs;                                   // 本步接触的碰撞对
+    ContactEvents m_contactEvents;                                   // 本步产生的事件
+    std::vector<ContactManifold> m_manifolds;                        // 本步接触流形（与m_contacts对齐）
+    std::vector<ContactManifold> m_manifoldCache;                    // 上一步的接触流形（按碰撞体对排序，用于热启动）
+
+    /**
+     * @brief 刚体运动状态数组（SoA），与m_rigidbodies按下标对齐
+     */
+    struct BodyStates {
+        std::vector<Transform*> transforms;       // 刚体所在的Transform
+        std::vector<Vector2> positions;           // 位置
+        std::vector<float> rotations;             // 旋转（弧度）
+        std::vector<Vector2> velocities;          // 线速度
+        std::vector<float> angularVelocities;     // 角速度
+        std::vector<Vector2> forces;              // 本步累积的力
+        std::vector<float> torques;               // 本步累积的扭矩
+        std::vector<float> inverseMasses;         // 质量倒数（仅动态刚体非0）
+        std::vector<float> inverseInertias;       // 转动惯量倒数（仅可旋转的动态刚体非0）
+        std::vector<float> gravityScales;         // 重力缩放（不受重力时为0）
+        std::vector<float> linearDampings;        // 线性阻尼
+        std::vector<float> angularDampings;       // 角阻尼
+        std::vector<float> simulated;             // 本步是否积分力（活动且醒着的动态刚体为1，否则为0）
+        std::vector<float> moving;                // 本步是否移动（活动且醒着的非静态刚体为1，否则为0）
+        std::vector<float> rotating;              // 本步是否转动（移动且不固定旋转为1，否则为0）
+
+        int size() const { return static_cast<int>(velocities.size()); }
+        void push();                              // 追加一个刚体的状态
+        void swapRemove(int index);               // 与末尾交换后删除
+        void clear();                             // 清空
+    };
+
+    BodyStates m_bodies;                                             // 刚体运动状态
+    std::unordered_map<Transform*, int> m_transformBodies;           // Transform -> 刚体下标
+    std::vector<int> m_ccdBodies;                                    // 本步启用连续碰撞检测的刚体下标
+    std::vector<Vector2> m_ccdStarts;                                // 启用CCD的刚体积分前的位置
+
+    // 休眠与接触岛
+    bool m_sleepingEnabled;                                          // 是否启用自动休眠
+    float m_linearSleepThreshold;                                    // 线速度休眠阈值
+    float m_angularSleepThreshold;                                   // 角速度休眠阈值
+    float m_timeToSleep;                                             // 进入休眠所需的静止时间
+    std::vector<float> m_sleepTimers;                                // 每个刚体的静止时间（与m_rigidbodies对齐）
+    std::vector<int> m_sleepLinks;                                   // 休眠岛的环形链表，保存岛内下一个刚体的下标，不在休眠岛中为-1（与m_rigidbodies对齐）
+    std::vector<int> m_islandParents;                                // 并查集父节点（每步复用）
+    std::vector<float> m_islandSleepTimes;                           // 每个岛的最小静止时间（每步复用）
+    std::vector<int> m_islandSleepHeads;                             // 每个岛休眠时链表的首个刚体（每步复用）
+
+    // 并行求解
+    std::unique_ptr<ThreadPool> m_threadPool;                        // 工作线程池（为空时串行）
+    std::vector<CollisionInfo> m_narrowphaseResults;                 // 每个碰撞对的窄相结果（每步复用）
+    std::vector<char> m_narrowphaseHits;                             // 每个碰撞对是否接触（每步复用）
+    std::vector<ContactManifold> m_narrowphaseManifolds;             // 每个碰撞对的接触流形（每步复用）
+    std::vector<ContactPoints> m_narrowphasePoints;                  // 每个碰撞对的接触点（每步复用）
+    std::vector<ColliderShape> m_narrowphaseShapes;                  // 每个碰撞对两侧的形状数据（每步复用）
+    std::vector<int> m_narrowphaseBatches[SHAPE_TYPE_COUNT * SHAPE_TYPE_COUNT];  // 按形状组合分组的碰撞对下标
+    std::vector<int> m_contactIslands;                               // 每个接触所属的岛（每步复用）
+    std::vector<int> m_islandContactStarts;                          // 每个岛在m_islandContacts中的起始位置
+    std::vector<int> m_islandContacts;                               // 按岛分组的接触下标
+    std::vector<int> m_islandFill;                                   // 分组时的写入位置（每步复用）
+    std::vector<int> m_solverIslands;                                // 本步有接触需要求解的岛
+
+    // 批量投射
+    std::vector<uint64_t> m_castOrder;                               // 高32位为射线中点的Morton码，低32位为射线下标（每批复用）
+    std::vector<Collider*> m_castColliders;                          // 本组的候选碰撞体（每组复用）
+    std::vector<ColliderShape> m_castShapes;                         // 候选碰撞体的形状数据（每组复用）
+    std::vector<float> m_castBounds;                                 // 候选包围盒，按minX/minY/maxX/maxY分段存放（每组复用）
+    std::vector<uint32_t> m_castLayers;                              // 候选碰撞体的层位（每组复用）
+    std::vector<int> m_castCandidates;                               // 单条射线通过包围盒测试的候选（每条复用）
 
     // 私有辅助方法
     void integrateForces(float deltaTime);    // 积分力
     void detectCollisions();                  // 检测碰撞
     void resolveCollisions();                 // 解决碰撞
     void integrateVelocities(float deltaTime); // 积分速度
+    void updateBodyMasks();                   // 根据刚体类型与休眠状态刷新本步的积分掩码
+    void integrateContinuous(int index, const Vector2& start, float deltaTime);  // 沿位移扫掠并在撞击时刻子步推进
+    bool sweepCollider(Collider* collider, const Vector2& offset, const Vector2& direction, float maxDistance,
+                       float& distance, Vector2& normal, Collider*& hitCollider);  // 求碰撞体沿方向的最早撞击
+    void writeBackTransforms();               // 将本步的位置和旋转批量写回Transform
+    void refreshBody(Rigidbody* rigidbody);   // 刚体属性变化后刷新状态数组中的派生数据
+    int getBodyIndex(const Rigidbody* rigidbody) const;  // 获取刚体在状态数组中的下标，不属于本世界时为-1
+    void updateProxy(Collider* collider);     // 更新单个动态碰撞体的宽相代理
+    void insertProxy(Collider* collider, uint32_t id);  // 按分区创建宽相代理
+    uint32_t getColliderId(const Collider* collider) const;  // 获取碰撞体的登记序号
+    void destroyProxy(Collider* collider);    // 销毁宽相代理
+    void queryStatic(const AABB& aabb, uint32_t layers, std::vector<Collider*>& results) const;  // 查询指定层的静态桶
+    bool layersCollide(const Collider* colliderA, const Collider* colliderB) const;  // 按层碰撞矩阵检查两个碰撞体
+    std::unique_ptr<Broadphase> createBroadphase(BroadphaseType type) const;  // 创建宽相后端
+    void dispatchEvents();                    // 比较前后两步的接触集合，生成并派发事件
+    void updateSleep(float deltaTime);        // 构建接触岛并让静止的岛整体休眠
+    int findIsland(int index);                // 并查集查找
+    bool filterPair(const BroadphasePair& pair) const;  // 检查碰撞对是否需要窄相检测
+    int overlapShape(const ColliderShape& shape, bool pointQuery, Collider** results, int maxResults,
+                     uint32_t layerMask);  // 区域查询的公共实现，点查询时只检查圆心是否被包含
+    int castBatch(const std::vector<Ray>& rays, float radius, const Vector2& halfExtents, bool boxCast,
+                  std::vector<RaycastHit>& hits, RaycastMode mode);  // 批量射线与形状投射的公共实现
+    void buildIslands();                      // 按接触构建岛并分组接触
+    void buildManifold(const CollisionInfo& info, const ContactPoints& points, int subShape,
+                       ContactManifold& manifold) const;  // 生成接触流形并从缓存热启动
+    void solveIsland(int island);             // 迭代求解一个岛内的接触
+    void prepareManifold(ContactManifold& manifold);  // 计算有效质量并施加热启动冲量
+    void solveManifold(ContactManifold& manifold);    // 求解单个流形的摩擦与法向冲量
+    template <typename RelativeVelocity, typename ApplyImpulse>
+    void solveNormalBlock(ContactManifold& manifold, const RelativeVelocity& relativeVelocity,
+                          const ApplyImpulse& applyImpulse);  // 联立求解两个接触点的法向冲量
+    void storeVelocities(const ContactManifold& manifold, const Vector2& velocityA, float angularA,
+                         const Vector2& velocityB, float angularB);  // 写回流形两侧动态刚体的速度
+    void runParallel(int count, int batchSize, const std::function<void(int, int)>& job);  // 并行执行或退化为串行
 };
 
 } // namespace Engine2D 
\ No newline at end of file
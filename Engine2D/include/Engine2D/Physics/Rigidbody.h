@@ -5,6 +5,8 @@
 
 namespace Engine2D {
 
+class PhysicsWorld;
+
 /**
  * @brief 刚体类型枚举
  */
@@ -16,8 +18,13 @@ enum class BodyType {
 
 /**
  * @brief 刚体组件，负责物理模拟
+ *
+ * 加入物理世界后，速度、力等运动状态保存在PhysicsWorld的连续数组中，
+ * 刚体只作为访问这些数据的句柄；移出物理世界时状态会复制回刚体
  */
 class Rigidbody : public Component {
+    friend class PhysicsWorld;
+
 public:
     /**
      * @brief 构造函数
@@ -37,6 +44,11 @@ public:
      */
     virtual void update(float deltaTime) override;
 
+    /**
+     * @brief 销毁刚体，从物理世界中移除
+     */
+    virtual void destroy() override;
+
     /**
      * @brief 设置刚体类型
      * @param type 刚体类型
@@ -61,6 +73,12 @@ public:
      */
     float getMass() const;
 
+    /**
+     * @brief 获取转动惯量倒数
+     * @return 转动惯量倒数，固定旋转时为0
+     */
+    float getInverseInertia() const;
+
     /**
      * @brief 设置线性阻尼
      * @param damping 线性阻尼
@@ -197,6 +215,8 @@ public:
 
     /**
      * @brief 设置是否使用连续碰撞检测
+     *
+     * 启用后物理世界会沿本步位移扫掠求撞击时刻并子步推进，防止高速物体穿过薄墙
      * @param use 是否使用
      */
     void setUseCCD(bool use);
@@ -209,6 +229,8 @@ public:
 
     /**
      * @brief 设置是否处于休眠状态
+     *
+     * 在物理世界中休眠时清零速度；唤醒时与其同属一个休眠岛的刚体也被唤醒
      * @param asleep 是否休眠
      */
     void setAsleep(bool asleep);
@@ -251,6 +273,8 @@ private:
     bool m_useCCD;                  // 是否使用连续碰撞检测
     bool m_asleep;                  // 是否休眠
     bool m_canSleep;                // 是否可以休眠
+    PhysicsWorld* m_world;          // 所属的物理世界（未加入时为空）
+    int m_bodyIndex;                // 在物理世界状态数组中的下标
 
     // 重新计算质量属性
     void recalculateMassData();
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Broadphase.h"
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace Engine2D {
+
+/**
+ * @brief 均匀网格空间哈希，用于宽相检测
+ *
+ * 每个代理按其包围盒覆盖的网格单元登记，移动时只有跨越单元边界才需要重新登记
+ */
+class SpatialHash : public Broadphase {
+public:
+    /**
+     * @brief 构造函数
+     * @param cellSize 网格单元大小
+     */
+    explicit SpatialHash(float cellSize = 64.0f);
+    virtual ~SpatialHash() override;
+
+    /**
+     * @brief 获取宽相类型
+     * @return 空间哈希类型
+     */
+    virtual BroadphaseType getType() const override;
+
+    /**
+     * @brief 设置网格单元大小，会重建所有单元
+     * @param cellSize 网格单元大小
+     */
+    void setCellSize(float cellSize);
+
+    /**
+     * @brief 获取网格单元大小
+     * @return 网格单元大小
+     */
+    float getCellSize() const;
+
+    /**
+     * @brief 创建代理
+     * @param aabb 包围盒
+     * @param collider 关联的碰撞体
+     * @return 代理ID
+     */
+    virtual int createProxy(const AABB& aabb, Collider* collider) override;
+
+    /**
+     * @brief 销毁代理
+     * @param proxyId 代理ID
+     */
+    virtual void destroyProxy(int proxyId) override;
+
+    /**
+     * @brief 移动代理
+     * @param proxyId 代理ID
+     * @param aabb 新包围盒
+     * @return 覆盖的网格单元是否发生变化
+     */
+    virtual bool moveProxy(int proxyId, const AABB& aabb) override;
+
+    /**
+     * @brief 获取代理的包围盒
+     * @param proxyId 代理ID
+     * @return 包围盒
+     */
+    virtual const AABB& getAABB(int proxyId) const override;
+
+    /**
+     * @brief 获取代理关联的碰撞体
+     * @param proxyId 代理ID
+     * @return 碰撞体指针
+     */
+    virtual Collider* getCollider(int proxyId) const override;
+
+    /**
+     * @brief 计算所有包围盒重叠的候选碰撞对
+     * @param pairs 输出缓冲区，会先被清空，容量保留以便复用
+     */
+    virtual void computePairs(std::vector<BroadphasePair>& pairs) const override;
+
+    /**
+     * @brief 查询与指定区域重叠的碰撞体
+     * @param aabb 查询区域
+     * @param results 输出列表（追加写入，不会清空）
+     */
+    virtual void query(const AABB& aabb, std::vector<Collider*>& results) const override;
+
+    /**
+     * @brief 沿射线遍历可能相交的碰撞体
+     * @param origin 射线起点
+     * @param direction 射线方向（单位向量）
+     * @param maxDistance 最大检测距离
+     * @param callback 候选碰撞体回调
+     */
+    virtual void raycast(const Vector2& origin, const Vector2& direction, float maxDistance,
+                         const BroadphaseRaycastCallback& callback) const override;
+
+    /**
+     * @brief 获取代理数量
+     * @return 代理数量
+     */
+    virtual int getProxyCount() const override;
+
+    /**
+     * @brief 清空所有代理和网格单元
+     */
+    virtual void clear() override;
+
+private:
+    struct Proxy {
+        AABB aabb;              // 包围盒
+        Collider* collider;     // 关联的碰撞体
+        int minX, minY;         // 覆盖的网格单元范围
+        int maxX, maxY;
+        int nextFree;           // 空闲链表（-1表示正在使用）
+    };
+
+    float m_cellSize;                                         // 网格单元大小
+    float m_inverseCellSize;                                  // 网格单元大小倒数
+    std::vector<Proxy> m_proxies;                             // 代理池
+    int m_freeList;                                           // 空闲代理链表头
+    int m_proxyCount;                                         // 正在使用的代理数量
+    std::unordered_map<int64_t, std::vector<int>> m_cells;    // 网格单元 -> 代理ID列表
+    mutable std::vector<Collider*> m_raycastCandidates;       // 射线检测的候选缓冲区（复用以避免分配）
+
+    // 私有辅助方法
+    void computeCellRange(const AABB& aabb, int& minX, int& minY, int& maxX, int& maxY) const;
+    void insertIntoCells(int proxyId);
+    void removeFromCells(int proxyId);
+    static int64_t cellKey(int x, int y);
+};
+
+} // namespace Engine2D
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Broadphase.h"
+#include <vector>
+#include <cstdint>
+
+namespace Engine2D {
+
+/**
+ * @brief 排序扫描（Sweep and Prune）宽相
+ *
+ * 沿扫描轴保存持久的端点数组，帧间用插入排序增量维护。
+ * 对于连贯运动（如下落的方块堆）端点顺序几乎不变，排序接近线性时间。
+ * 扫描时先用缓存的层位和碰撞掩码过滤，再测试另一轴的重叠
+ */
+class SweepAndPrune : public Broadphase {
+public:
+    /**
+     * @brief 构造函数
+     * @param axis 扫描轴（0为X轴，1为Y轴）
+     */
+    explicit SweepAndPrune(int axis = 0);
+    virtual ~SweepAndPrune() override;
+
+    /**
+     * @brief 获取宽相类型
+     * @return 排序扫描类型
+     */
+    virtual BroadphaseType getType() const override;
+
+    /**
+     * @brief 设置扫描轴，会重建端点数组
+     * @param axis 扫描轴（0为X轴，1为Y轴）
+     */
+    void setAxis(int axis);
+
+    /**
+     * @brief 获取扫描轴
+     * @return 扫描轴
+     */
+    int getAxis() const;
+
+    /**
+     * @brief 创建代理
+     * @param aabb 包围盒
+     * @param collider 关联的碰撞体（可为空，为空时不做层过滤）
+     * @return 代理ID
+     */
+    virtual int createProxy(const AABB& aabb, Collider* collider) override;
+
+    /**
+     * @brief 销毁代理
+     * @param proxyId 代理ID
+     */
+    virtual void destroyProxy(int proxyId) override;
+
+    /**
+     * @brief 移动代理，端点在下次计算碰撞对时统一重新排序
+     * @param proxyId 代理ID
+     * @param aabb 新包围盒
+     * @return 总是返回true
+     */
+    virtual bool moveProxy(int proxyId, const AABB& aabb) override;
+
+    /**
+     * @brief 获取代理的包围盒
+     * @param proxyId 代理ID
+     * @return 包围盒
+     */
+    virtual const AABB& getAABB(int proxyId) const override;
+
+    /**
+     * @brief 获取代理关联的碰撞体
+     * @param proxyId 代理ID
+     * @return 碰撞体指针
+     */
+    virtual Collider* getCollider(int proxyId) const override;
+
+    /**
+     * @brief 重新排序端点并扫描出所有重叠且层过滤通过的碰撞对
+     * @param pairs 输出缓冲区，会先被清空，容量保留以便复用
+     */
+    virtual void computePairs(std::vector<BroadphasePair>& pairs) const override;
+
+    /**
+     * @brief 查询与指定区域重叠的碰撞体
+     * @param aabb 查询区域
+     * @param results 输出列表（追加写入，不会清空）
+     */
+    virtual void query(const AABB& aabb, std::vector<Collider*>& results) const override;
+
+    /**
+     * @brief 沿射线遍历可能相交的碰撞体
+     * @param origin 射线起点
+     * @param direction 射线方向（单位向量）
+     * @param maxDistance 最大检测距离
+     * @param callback 候选碰撞体回调
+     */
+    virtual void raycast(const Vector2& origin, const Vector2& direction, float maxDistance,
+                         const BroadphaseRaycastCallback& callback) const override;
+
+    /**
+     * @brief 获取代理数量
+     * @return 代理数量
+     */
+    virtual int getProxyCount() const override;
+
+    /**
+     * @brief 清空所有代理和端点
+     */
+    virtual void clear() override;
+
+private:
+    struct Proxy {
+        AABB aabb;              // 包围盒
+        Collider* collider;     // 关联的碰撞体
+        uint32_t layerBit;      // 所在层的位
+        uint32_t mask;          // 碰撞掩码
+        int activeIndex;        // 在活动列表中的位置（扫描时使用）
+        int nextFree;           // 空闲链表（-1表示正在使用）
+    };
+
+    struct Endpoint {
+        float value;            // 端点在扫描轴上的坐标
+        int proxyId;            // 所属代理
+        bool isMin;             // 是否为最小端点
+    };
+
+    int m_axis;                              // 扫描轴
+    mutable std::vector<Proxy> m_proxies;    // 代理池
+    mutable std::vector<Endpoint> m_endpoints;  // 沿扫描轴排序的端点
+    mutable std::vector<int> m_active;       // 扫描时的活动代理列表
+    mutable std::vector<Collider*> m_raycastCandidates;  // 射线检测的候选缓冲区
+    mutable bool m_endpointsDirty;           // 上次排序后是否有代理创建或移动
+    int m_freeList;                          // 空闲代理链表头
+    int m_proxyCount;                        // 正在使用的代理数量
+
+    // 私有辅助方法
+    void refreshFilter(Proxy& proxy) const;
+    void sortEndpoints() const;
+    float minOnAxis(const AABB& aabb) const;
+    float maxOnAxis(const AABB& aabb) const;
+};
+
+} // namespace Engine2D
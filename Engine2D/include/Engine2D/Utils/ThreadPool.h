@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine2D {
+
+/**
+ * @brief 固定大小的工作线程池，提供阻塞式的并行for
+ *
+ * 任务按固定大小切分为批次，调用线程也参与执行。
+ * 每个下标只会被处理一次，只要任务把结果写入按下标划分的位置，
+ * 结果就与线程数无关
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief 并行任务类型，参数为批次的起止下标 [begin, end)
+     */
+    using RangeJob = std::function<void(int begin, int end)>;
+
+    /**
+     * @brief 构造函数
+     * @param threadCount 工作线程数量（不含调用线程），0表示全部在调用线程执行
+     */
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    /**
+     * @brief 获取工作线程数量
+     * @return 工作线程数量
+     */
+    int getThreadCount() const;
+
+    /**
+     * @brief 并行执行任务，返回时所有批次均已完成
+     * @param count 下标总数
+     * @param batchSize 每个批次的下标数量
+     * @param job 批次任务
+     */
+    void parallelFor(int count, int batchSize, const RangeJob& job);
+
+private:
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void workerLoop();
+    void runBatches();
+
+    std::vector<std::thread> m_workers;     // 工作线程
+    std::mutex m_mutex;                     // 保护任务状态
+    std::condition_variable m_wakeWorkers;  // 通知工作线程有新任务
+    std::condition_variable m_jobDone;      // 通知调用线程任务完成
+
+    const RangeJob* m_job;                  // 当前任务
+    int m_count;                            // 当前任务的下标总数
+    int m_batchSize;                        // 当前任务的批次大小
+    std::atomic<int> m_nextBatch;           // 下一个待领取的批次
+    int m_batchCount;                       // 当前任务的批次数
+    int m_busyWorkers;                      // 仍在执行当前任务的工作线程数
+    unsigned int m_generation;              // 任务代号，用于唤醒工作线程
+    bool m_stopping;                        // 是否正在关闭
+};
+
+} // namespace Engine2D
@@ -1,6 +1,8 @@
 #include "Engine2D/Core/Engine.h"
 #include "Engine2D/Core/SceneManager.h"
+#include "Engine2D/Core/Transform.h"
 #include "Engine2D/Graphics/Renderer.h"
+#include "Engine2D/Graphics/SpriteBatch.h"
 #include "Engine2D/Input/InputManager.h"
 #include "Engine2D/Physics/PhysicsWorld.h"
 #include "Engine2D/Audio/AudioManager.h"
@@ -48,6 +50,8 @@ bool Engine::initialize(const std::string& title, int width, int height, bool fu
         }
         LOG_INFO("渲染器初始化成功");
 
+        m_spriteBatch = std::make_unique<SpriteBatch>();
+
         m_inputManager = std::make_unique<InputManager>();
         m_inputManager->initialize();
         LOG_INFO("输入管理器初始化成功");
@@ -102,6 +106,10 @@ void Engine::run() {
         // 渲染
         render();
 
+        // 同步游戏逻辑本帧移动的物体后清空移动列表
+        m_physicsWorld->syncTransforms();
+        Transform::clearMovedTransforms();
+
         // 计算帧率
         calculateFPS();
 
@@ -170,8 +178,11 @@ void Engine::render() {
     // 清除屏幕
     m_renderer->clear();
 
-    // 渲染当前场景
+    // 渲染当前场景，精灵渲染组件经视野剔除后提交，期间提交的精灵排序后批量绘制
+    m_spriteBatch->begin(m_renderer.get());
+    m_spriteBatch->submitVisible();
     m_sceneManager->render();
+    m_spriteBatch->end();
 
     // 呈现画面
     m_renderer->present();
@@ -197,6 +208,10 @@ Renderer* Engine::getRenderer() const {
     return m_renderer.get();
 }
 
+SpriteBatch* Engine::getSpriteBatch() const {
+    return m_spriteBatch.get();
+}
+
 InputManager* Engine::getInputManager() const {
     return m_inputManager.get();
 }
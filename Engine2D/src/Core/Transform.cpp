@@ -5,6 +5,8 @@
 
 namespace Engine2D {
 
+std::vector<Transform*> Transform::s_movedTransforms;
+
 Transform::Transform()
     : m_localPosition(0.0f, 0.0f)
     , m_localRotation(0.0f)
@@ -13,7 +15,8 @@ Transform::Transform()
     , m_worldRotation(0.0f)
     , m_worldScale(1.0f, 1.0f)
     , m_parent(nullptr)
-    , m_dirty(true) {
+    , m_dirty(true)
+    , m_moved(false) {
     setName("Transform");
 }
 
@@ -27,6 +30,15 @@ Transform::~Transform() {
     if (m_parent) {
         m_parent->removeChild(this);
     }
+
+    // 从移动列表中移除，避免空间索引访问悬空指针
+    if (m_moved) {
+        auto it = std::find(s_movedTransforms.begin(), s_movedTransforms.end(), this);
+        if (it != s_movedTransforms.end()) {
+            *it = s_movedTransforms.back();
+            s_movedTransforms.pop_back();
+        }
+    }
 }
 
 void Transform::initialize() {
@@ -43,6 +55,7 @@ void Transform::setPosition(const Vector2& position) {
         m_localPosition = position;
     }
     m_dirty = true;
+    markMoved();
 }
 
 void Transform::setPosition(float x, float y) {
@@ -59,6 +72,7 @@ const Vector2& Transform::getPosition() const {
 void Transform::translate(const Vector2& translation) {
     m_localPosition = m_localPosition + translation;
     m_dirty = true;
+    markMoved();
 }
 
 void Transform::translate(float x, float y) {
@@ -72,6 +86,7 @@ void Transform::setRotation(float rotation) {
         m_localRotation = rotation;
     }
     m_dirty = true;
+    markMoved();
 }
 
 float Transform::getRotation() const {
@@ -84,6 +99,7 @@ float Transform::getRotation() const {
 void Transform::rotate(float angle) {
     m_localRotation += angle;
     m_dirty = true;
+    markMoved();
 }
 
 void Transform::setScale(const Vector2& scale) {
@@ -94,6 +110,7 @@ void Transform::setScale(const Vector2& scale) {
         m_localScale = scale;
     }
     m_dirty = true;
+    markMoved();
 }
 
 void Transform::setScale(float x, float y) {
@@ -129,6 +146,7 @@ void Transform::setParent(Transform* parent) {
     }
 
     m_dirty = true;
+    markMoved();
 }
 
 Transform* Transform::getParent() const {
@@ -140,6 +158,7 @@ void Transform::addChild(Transform* child) {
         m_children.push_back(child);
         child->m_parent = this;
         child->m_dirty = true;
+        child->markMoved();
     }
 }
 
@@ -149,6 +168,7 @@ bool Transform::removeChild(Transform* child) {
         m_children.erase(it);
         child->m_parent = nullptr;
         child->m_dirty = true;
+        child->markMoved();
         return true;
     }
     return false;
@@ -165,6 +185,7 @@ const Vector2& Transform::getLocalPosition() const {
 void Transform::setLocalPosition(const Vector2& position) {
     m_localPosition = position;
     m_dirty = true;
+    markMoved();
 }
 
 float Transform::getLocalRotation() const {
@@ -174,6 +195,7 @@ float Transform::getLocalRotation() const {
 void Transform::setLocalRotation(float rotation) {
     m_localRotation = rotation;
     m_dirty = true;
+    markMoved();
 }
 
 const Vector2& Transform::getLocalScale() const {
@@ -183,6 +205,7 @@ const Vector2& Transform::getLocalScale() const {
 void Transform::setLocalScale(const Vector2& scale) {
     m_localScale = scale;
     m_dirty = true;
+    markMoved();
 }
 
 Vector2 Transform::getForward() const {
@@ -233,4 +256,31 @@ void Transform::updateWorldTransform() {
     }
 }
 
+bool Transform::hasMoved() const {
+    return m_moved;
+}
+
+const std::vector<Transform*>& Transform::getMovedTransforms() {
+    return s_movedTransforms;
+}
+
+void Transform::clearMovedTransforms() {
+    for (auto transform : s_movedTransforms) {
+        transform->m_moved = false;
+    }
+    s_movedTransforms.clear();
+}
+
+void Transform::markMoved() {
+    if (!m_moved) {
+        m_moved = true;
+        s_movedTransforms.push_back(this);
+    }
+
+    // 子对象的世界变换随父对象一起变化
+    for (auto child : m_children) {
+        child->markMoved();
+    }
+}
+
 } // namespace Engine2D 
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "Engine2D/Graphics/RenderQueue.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Engine2D {
+
+namespace {
+    const int RADIX_BITS = 8;                       // 每趟处理的位数
+    const int RADIX_SIZE = 1 << RADIX_BITS;         // 每趟的桶数量
+    const int RADIX_PASSES = 64 / RADIX_BITS;       // 64位键需要的趟数
+
+    // 把浮点数映射为按数值大小排序的无符号整数
+    uint32_t sortableFloat(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+}
+
+uint64_t RenderCommand::makeSortKey(int layer, float depth, SDL_BlendMode blendMode, SDL_Texture* texture) {
+    const uint64_t layerBits = static_cast<uint64_t>(std::min(std::max(layer, -128), 127) + 128);
+    const uint64_t depthBits = sortableFloat(depth) >> 8;
+    const uint64_t materialBits = static_cast<uint64_t>(blendMode) & 0xFFu;
+
+    // 指针低位因对齐恒为0，乘法散列后取高位使不同纹理尽量落在不同的值上
+    const uint64_t textureHash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(texture)) * 0x9E3779B97F4A7C15ull;
+    const uint64_t textureBits = textureHash >> 40;
+
+    return (layerBits << 56) | (depthBits << 32) | (materialBits << 24) | textureBits;
+}
+
+RenderQueue::RenderQueue() {
+}
+
+RenderQueue::~RenderQueue() {
+}
+
+void RenderQueue::submit(const RenderCommand& command) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_commands.push_back(command);
+}
+
+void RenderQueue::submit(const RenderCommand* commands, size_t count) {
+    if (!commands || count == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_commands.insert(m_commands.end(), commands, commands + count);
+}
+
+void RenderQueue::sort() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const size_t count = m_commands.size();
+    m_entries.resize(count);
+    m_scratch.resize(count);
+
+    // 一次遍历同时统计所有趟的直方图
+    uint32_t histograms[RADIX_PASSES][RADIX_SIZE] = {};
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t key = m_commands[i].sortKey;
+        m_entries[i].key = key;
+        m_entries[i].index = static_cast<uint32_t>(i);
+        for (int pass = 0; pass < RADIX_PASSES; ++pass) {
+            ++histograms[pass][(key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1)];
+        }
+    }
+
+    SortEntry* source = m_entries.data();
+    SortEntry* target = m_scratch.data();
+    for (int pass = 0; pass < RADIX_PASSES; ++pass) {
+        uint32_t* histogram = histograms[pass];
+        const int shift = pass * RADIX_BITS;
+
+        // 所有键在这一字节上都相同时顺序不变，跳过这一趟（例如未使用的层和深度）
+        if (count == 0 || histogram[(source[0].key >> shift) & (RADIX_SIZE - 1)] == count) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < RADIX_SIZE; ++bucket) {
+            const uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            target[histogram[(source[i].key >> shift) & (RADIX_SIZE - 1)]++] = source[i];
+        }
+        std::swap(source, target);
+    }
+
+    // 奇数趟后结果在临时缓冲区中
+    if (source != m_entries.data()) {
+        m_entries.swap(m_scratch);
+    }
+}
+
+void RenderQueue::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_commands.clear();
+    m_entries.clear();
+}
+
+size_t RenderQueue::getCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_commands.size();
+}
+
+const RenderCommand& RenderQueue::getSorted(size_t index) const {
+    return m_commands[m_entries[index].index];
+}
+
+} // namespace Engine2D
@@ -0,0 +1,351 @@
+#include "Engine2D/Graphics/SpriteBatch.h"
+#include "Engine2D/Graphics/Sprite.h"
+#include "Engine2D/Graphics/Camera.h"
+#include "Engine2D/Graphics/SpriteRenderer.h"
+#include "Engine2D/Core/GameObject.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Engine2D {
+
+SpriteBatch::SpriteBatch()
+    : m_renderer(nullptr)
+    , m_active(false)
+    , m_cullingEnabled(true)
+    , m_spriteCount(0)
+    , m_culledCount(0)
+    , m_drawCallCount(0) {
+}
+
+SpriteBatch::~SpriteBatch() {
+}
+
+void SpriteBatch::begin(Renderer* renderer) {
+    m_renderer = renderer;
+    m_active = renderer != nullptr;
+    m_spriteCount = 0;
+    m_culledCount = 0;
+    m_drawCallCount = 0;
+    m_queue.clear();
+    if (m_active) {
+        computeViewBounds();
+    }
+}
+
+void SpriteBatch::submitVisible() {
+    if (!m_active) {
+        return;
+    }
+
+    // 只有本帧移动过的组件需要更新包围盒，在胖包围盒内移动时树结构不变
+    for (Transform* transform : Transform::getMovedTransforms()) {
+        auto it = m_transformRenderables.find(transform);
+        if (it == m_transformRenderables.end()) {
+            continue;
+        }
+        for (SpriteRenderer* renderable : it->second) {
+            m_cullingTree.moveProxy(m_renderableProxies[renderable].proxyId, renderable->getBounds());
+        }
+    }
+
+    m_visibleProxies.clear();
+    if (m_cullingEnabled) {
+        m_cullingTree.queryProxies(m_viewBounds, m_visibleProxies);
+        m_culledCount += getRenderableCount() - static_cast<int>(m_visibleProxies.size());
+    } else {
+        for (int proxyId = 0; proxyId < static_cast<int>(m_proxyRenderables.size()); ++proxyId) {
+            if (m_proxyRenderables[proxyId]) {
+                m_visibleProxies.push_back(proxyId);
+            }
+        }
+    }
+
+    for (int proxyId : m_visibleProxies) {
+        SpriteRenderer* renderable = m_proxyRenderables[proxyId];
+        GameObject* gameObject = renderable->getGameObject();
+        if (renderable->isActive() && gameObject && gameObject->isActive()) {
+            renderable->submit(*this);
+        }
+    }
+}
+
+void SpriteBatch::draw(Sprite* sprite, const Vector2& position, float rotation,
+                       const Vector2& scale, const Color& color, int layer, SDL_BlendMode blendMode,
+                       float depth) {
+    if (!sprite || !sprite->isValid()) {
+        return;
+    }
+    draw(sprite->getTexture(), sprite->getSourceRect(), position, rotation, scale, color, layer, blendMode, depth);
+}
+
+void SpriteBatch::draw(SDL_Texture* texture, const SDL_Rect& sourceRect, const Vector2& position,
+                       float rotation, const Vector2& scale, const Color& color, int layer,
+                       SDL_BlendMode blendMode, float depth) {
+    if (!m_active || !texture || sourceRect.w <= 0 || sourceRect.h <= 0) {
+        return;
+    }
+
+    // 用外接圆半径做保守测试，省去三角函数
+    const float halfWidth = sourceRect.w * scale.x * 0.5f;
+    const float halfHeight = sourceRect.h * scale.y * 0.5f;
+    if (m_cullingEnabled) {
+        const float radius = std::sqrt(halfWidth * halfWidth + halfHeight * halfHeight);
+        if (position.x + radius < m_viewBounds.min.x || position.x - radius > m_viewBounds.max.x ||
+            position.y + radius < m_viewBounds.min.y || position.y - radius > m_viewBounds.max.y) {
+            ++m_culledCount;
+            return;
+        }
+    }
+
+    RenderCommand command;
+    command.sortKey = RenderCommand::makeSortKey(layer, depth, blendMode, texture);
+    command.texture = texture;
+    command.sourceRect = sourceRect;
+    command.x = position.x;
+    command.y = position.y;
+    command.halfWidth = halfWidth;
+    command.halfHeight = halfHeight;
+    command.rotation = rotation;
+    command.color = { color.r, color.g, color.b, color.a };
+    command.blendMode = blendMode;
+    m_queue.submit(command);
+}
+
+void SpriteBatch::submit(const RenderCommand& command) {
+    if (!m_active || !command.texture) {
+        return;
+    }
+    m_queue.submit(command);
+}
+
+void SpriteBatch::submit(const RenderCommand* commands, size_t count) {
+    if (!m_active) {
+        return;
+    }
+    m_queue.submit(commands, count);
+}
+
+void SpriteBatch::flush() {
+    const size_t count = m_queue.getCount();
+    if (!m_active || count == 0) {
+        return;
+    }
+
+    SDL_Renderer* sdlRenderer = m_renderer->getSDLRenderer();
+    if (!sdlRenderer) {
+        m_queue.clear();
+        return;
+    }
+
+    m_queue.sort();
+
+    // 每段连续的相同纹理与混合模式合并为一次绘制，纹理散列冲突时也在这里断开
+    size_t start = 0;
+    while (start < count) {
+        const RenderCommand& first = m_queue.getSorted(start);
+        size_t end = start + 1;
+        while (end < count) {
+            const RenderCommand& next = m_queue.getSorted(end);
+            if (next.texture != first.texture || next.blendMode != first.blendMode) {
+                break;
+            }
+            ++end;
+        }
+        submitBatch(sdlRenderer, start, end);
+        start = end;
+    }
+
+    m_spriteCount += static_cast<int>(count);
+    m_queue.clear();
+}
+
+void SpriteBatch::end() {
+    flush();
+    m_active = false;
+}
+
+void SpriteBatch::addRenderable(SpriteRenderer* renderable) {
+    if (!renderable || m_renderableProxies.count(renderable)) {
+        return;
+    }
+
+    const int proxyId = m_cullingTree.createProxy(renderable->getBounds(), nullptr);
+    if (proxyId >= static_cast<int>(m_proxyRenderables.size())) {
+        m_proxyRenderables.resize(proxyId + 1, nullptr);
+    }
+    m_proxyRenderables[proxyId] = renderable;
+
+    Transform* transform = renderable->getTransform();
+    m_renderableProxies[renderable] = { proxyId, transform };
+    if (transform) {
+        m_transformRenderables[transform].push_back(renderable);
+    }
+}
+
+void SpriteBatch::removeRenderable(SpriteRenderer* renderable) {
+    auto it = m_renderableProxies.find(renderable);
+    if (it == m_renderableProxies.end()) {
+        return;
+    }
+
+    const RenderableProxy proxy = it->second;
+    m_renderableProxies.erase(it);
+    m_cullingTree.destroyProxy(proxy.proxyId);
+    m_proxyRenderables[proxy.proxyId] = nullptr;
+
+    auto transformIt = m_transformRenderables.find(proxy.transform);
+    if (transformIt != m_transformRenderables.end()) {
+        std::vector<SpriteRenderer*>& renderables = transformIt->second;
+        renderables.erase(std::remove(renderables.begin(), renderables.end(), renderable), renderables.end());
+        if (renderables.empty()) {
+            m_transformRenderables.erase(transformIt);
+        }
+    }
+}
+
+void SpriteBatch::updateRenderable(SpriteRenderer* renderable) {
+    auto it = m_renderableProxies.find(renderable);
+    if (it != m_renderableProxies.end()) {
+        m_cullingTree.moveProxy(it->second.proxyId, renderable->getBounds());
+    }
+}
+
+int SpriteBatch::getRenderableCount() const {
+    return static_cast<int>(m_renderableProxies.size());
+}
+
+void SpriteBatch::setCullingEnabled(bool enabled) {
+    m_cullingEnabled = enabled;
+}
+
+bool SpriteBatch::isCullingEnabled() const {
+    return m_cullingEnabled;
+}
+
+const AABB& SpriteBatch::getViewBounds() const {
+    return m_viewBounds;
+}
+
+bool SpriteBatch::isActive() const {
+    return m_active;
+}
+
+int SpriteBatch::getPendingCount() const {
+    return static_cast<int>(m_queue.getCount());
+}
+
+int SpriteBatch::getSpriteCount() const {
+    return m_spriteCount;
+}
+
+int SpriteBatch::getCulledCount() const {
+    return m_culledCount;
+}
+
+int SpriteBatch::getDrawCallCount() const {
+    return m_drawCallCount;
+}
+
+void SpriteBatch::computeViewBounds() {
+    Camera* camera = m_renderer->getCamera();
+    int width = m_renderer->getWidth();
+    int height = m_renderer->getHeight();
+    if (!camera) {
+        m_viewBounds = AABB(Vector2(0.0f, 0.0f), Vector2(static_cast<float>(width), static_cast<float>(height)));
+        return;
+    }
+
+    if (camera->getViewportWidth() > 0 && camera->getViewportHeight() > 0) {
+        width = camera->getViewportWidth();
+        height = camera->getViewportHeight();
+    }
+
+    // 摄像机可能旋转，取屏幕四个角在世界空间中的包围盒
+    const Vector2 corners[4] = {
+        camera->screenToWorld(Vector2(0.0f, 0.0f)),
+        camera->screenToWorld(Vector2(static_cast<float>(width), 0.0f)),
+        camera->screenToWorld(Vector2(static_cast<float>(width), static_cast<float>(height))),
+        camera->screenToWorld(Vector2(0.0f, static_cast<float>(height)))
+    };
+    m_viewBounds = AABB(corners[0], corners[0]);
+    for (int i = 1; i < 4; ++i) {
+        m_viewBounds = AABB::merge(m_viewBounds, AABB(corners[i], corners[i]));
+    }
+}
+
+void SpriteBatch::submitBatch(SDL_Renderer* sdlRenderer, size_t begin, size_t end) {
+    const int count = static_cast<int>(end - begin);
+    const RenderCommand& first = m_queue.getSorted(begin);
+    SDL_Texture* texture = first.texture;
+
+    // 整批共用一个纹理，纹理尺寸只查询一次
+    int textureWidth = 0;
+    int textureHeight = 0;
+    SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight);
+    if (textureWidth <= 0 || textureHeight <= 0) {
+        return;
+    }
+    const float inverseWidth = 1.0f / textureWidth;
+    const float inverseHeight = 1.0f / textureHeight;
+
+    // 摄像机的缩放和旋转同时作用于精灵的朝向：从摄像机变换中取出世界X、Y轴在屏幕上的方向和长度，
+    // 在摄像机位置附近按较长的距离求差，减小浮点抵消误差
+    Camera* camera = m_renderer->getCamera();
+    Vector2 screenAxisX(1.0f, 0.0f);
+    Vector2 screenAxisY(0.0f, 1.0f);
+    if (camera) {
+        const float step = 1024.0f;
+        const Vector2& reference = camera->getPosition();
+        const Vector2 origin = camera->worldToScreen(reference);
+        screenAxisX = (camera->worldToScreen(reference + Vector2(step, 0.0f)) - origin) / step;
+        screenAxisY = (camera->worldToScreen(reference + Vector2(0.0f, step)) - origin) / step;
+    }
+
+    m_vertices.resize(count * 4);
+    for (int i = 0; i < count; ++i) {
+        const RenderCommand& command = m_queue.getSorted(begin + i);
+        const Vector2 position(command.x, command.y);
+        const Vector2 center = camera ? camera->worldToScreen(position) : position;
+        const float u0 = command.sourceRect.x * inverseWidth;
+        const float v0 = command.sourceRect.y * inverseHeight;
+        const float u1 = (command.sourceRect.x + command.sourceRect.w) * inverseWidth;
+        const float v1 = (command.sourceRect.y + command.sourceRect.h) * inverseHeight;
+
+        // 半尺寸沿精灵旋转后的两条轴展开，再变换到屏幕空间，得到四个角相对中心的偏移
+        const float cosine = std::cos(command.rotation);
+        const float sine = std::sin(command.rotation);
+        const float hx = command.halfWidth;
+        const float hy = command.halfHeight;
+        const Vector2 axisX = screenAxisX * (hx * cosine) + screenAxisY * (hx * sine);
+        const Vector2 axisY = screenAxisX * (-hy * sine) + screenAxisY * (hy * cosine);
+
+        SDL_Vertex* quad = &m_vertices[i * 4];
+        quad[0] = { { center.x - axisX.x - axisY.x, center.y - axisX.y - axisY.y }, command.color, { u0, v0 } };
+        quad[1] = { { center.x + axisX.x - axisY.x, center.y + axisX.y - axisY.y }, command.color, { u1, v0 } };
+        quad[2] = { { center.x + axisX.x + axisY.x, center.y + axisX.y + axisY.y }, command.color, { u1, v1 } };
+        quad[3] = { { center.x - axisX.x + axisY.x, center.y - axisX.y + axisY.y }, command.color, { u0, v1 } };
+    }
+
+    // 索引只依赖四边形数量，容量不足时补齐新增部分
+    const int indexCount = count * 6;
+    const int generated = static_cast<int>(m_indices.size()) / 6;
+    if (generated < count) {
+        m_indices.resize(indexCount);
+        for (int i = generated; i < count; ++i) {
+            int* quad = &m_indices[i * 6];
+            const int base = i * 4;
+            quad[0] = base;
+            quad[1] = base + 1;
+            quad[2] = base + 2;
+            quad[3] = base + 2;
+            quad[4] = base + 3;
+            quad[5] = base;
+        }
+    }
+
+    SDL_SetTextureBlendMode(texture, first.blendMode);
+    SDL_RenderGeometry(sdlRenderer, texture, m_vertices.data(), count * 4, m_indices.data(), indexCount);
+    ++m_drawCallCount;
+}
+
+} // namespace Engine2D
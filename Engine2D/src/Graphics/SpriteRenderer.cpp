@@ -0,0 +1,147 @@
+#include "Engine2D/Graphics/SpriteRenderer.h"
+#include "Engine2D/Graphics/SpriteBatch.h"
+#include "Engine2D/Graphics/Sprite.h"
+#include "Engine2D/Core/Transform.h"
+#include "Engine2D/Core/Engine.h"
+#include <cmath>
+
+namespace Engine2D {
+
+SpriteRenderer::SpriteRenderer(Sprite* sprite)
+    : m_sprite(sprite)
+    , m_texture(nullptr)
+    , m_sourceRect({ 0, 0, 0, 0 })
+    , m_color(Color::WHITE)
+    , m_layer(0)
+    , m_depth(0.0f)
+    , m_blendMode(SDL_BLENDMODE_BLEND)
+    , m_batch(nullptr) {
+    setName("SpriteRenderer");
+}
+
+SpriteRenderer::~SpriteRenderer() {
+    if (m_batch) {
+        m_batch->removeRenderable(this);
+    }
+}
+
+void SpriteRenderer::initialize() {
+    Component::initialize();
+
+    if (SpriteBatch* batch = Engine::getInstance().getSpriteBatch()) {
+        m_batch = batch;
+        m_batch->addRenderable(this);
+    }
+}
+
+void SpriteRenderer::destroy() {
+    if (m_batch) {
+        m_batch->removeRenderable(this);
+        m_batch = nullptr;
+    }
+    Component::destroy();
+}
+
+void SpriteRenderer::setSprite(Sprite* sprite) {
+    m_sprite = sprite;
+    m_texture = nullptr;
+    if (m_batch) {
+        m_batch->updateRenderable(this);
+    }
+}
+
+void SpriteRenderer::setRegion(SDL_Texture* texture, const SDL_Rect& sourceRect) {
+    m_sprite = nullptr;
+    m_texture = texture;
+    m_sourceRect = sourceRect;
+    if (m_batch) {
+        m_batch->updateRenderable(this);
+    }
+}
+
+Sprite* SpriteRenderer::getSprite() const {
+    return m_sprite;
+}
+
+void SpriteRenderer::setColor(const Color& color) {
+    m_color = color;
+}
+
+const Color& SpriteRenderer::getColor() const {
+    return m_color;
+}
+
+void SpriteRenderer::setLayer(int layer) {
+    m_layer = layer;
+}
+
+int SpriteRenderer::getLayer() const {
+    return m_layer;
+}
+
+void SpriteRenderer::setDepth(float depth) {
+    m_depth = depth;
+}
+
+float SpriteRenderer::getDepth() const {
+    return m_depth;
+}
+
+void SpriteRenderer::setBlendMode(SDL_BlendMode blendMode) {
+    m_blendMode = blendMode;
+}
+
+SDL_BlendMode SpriteRenderer::getBlendMode() const {
+    return m_blendMode;
+}
+
+AABB SpriteRenderer::getBounds() const {
+    Transform* transform = getTransform();
+    if (!transform) {
+        return AABB();
+    }
+
+    const Vector2& position = transform->getPosition();
+    SDL_Texture* texture = nullptr;
+    SDL_Rect source;
+    if (!getSource(texture, source)) {
+        return AABB(position, position);
+    }
+
+    // 旋转后矩形的包围盒半尺寸
+    const Vector2& scale = transform->getScale();
+    const float halfWidth = std::fabs(source.w * scale.x) * 0.5f;
+    const float halfHeight = std::fabs(source.h * scale.y) * 0.5f;
+    const float cosine = std::fabs(std::cos(transform->getRotation()));
+    const float sine = std::fabs(std::sin(transform->getRotation()));
+    const Vector2 extents(cosine * halfWidth + sine * halfHeight, sine * halfWidth + cosine * halfHeight);
+    return AABB(position - extents, position + extents);
+}
+
+void SpriteRenderer::submit(SpriteBatch& batch) const {
+    Transform* transform = getTransform();
+    SDL_Texture* texture = nullptr;
+    SDL_Rect source;
+    if (!transform || !getSource(texture, source)) {
+        return;
+    }
+    batch.draw(texture, source, transform->getPosition(), transform->getRotation(), transform->getScale(),
+               m_color, m_layer, m_blendMode, m_depth);
+}
+
+bool SpriteRenderer::getSource(SDL_Texture*& texture, SDL_Rect& sourceRect) const {
+    if (m_sprite) {
+        if (!m_sprite->isValid()) {
+            return false;
+        }
+        texture = m_sprite->getTexture();
+        sourceRect = m_sprite->getSourceRect();
+        return true;
+    }
+
+    texture = m_texture;
+    sourceRect = m_sourceRect;
+    return texture != nullptr && sourceRect.w > 0 && sourceRect.h > 0;
+}
+
+} // namespace Engine2D
@@ -0,0 +1,397 @@
+#include "Engine2D/Graphics/TextureAtlas.h"
+#include "Engine2D/Utils/Logger.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <limits>
+
+namespace Engine2D {
+
+namespace {
+    const char* ATLAS_HEADER = "# Engine2D texture atlas";    // 描述文件的首行
+
+    // 拼接目录和文件名
+    std::string joinPath(const std::string& directory, const std::string& filename) {
+        if (directory.empty() || directory.back() == '/' || directory.back() == '\\') {
+            return directory + filename;
+        }
+        return directory + "/" + filename;
+    }
+
+    // 取路径中的目录部分（含末尾分隔符）
+    std::string directoryOf(const std::string& filepath) {
+        const size_t separator = filepath.find_last_of("/\\");
+        return separator == std::string::npos ? std::string() : filepath.substr(0, separator + 1);
+    }
+}
+
+AtlasPacker::AtlasPacker(int width, int height) {
+    reset(width, height);
+}
+
+void AtlasPacker::reset(int width, int height) {
+    m_width = width;
+    m_height = height;
+    m_skyline.clear();
+    m_skyline.push_back({ 0, 0, width });
+}
+
+bool AtlasPacker::insert(int width, int height, int& x, int& y) {
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    // 选择放置后顶部最低的位置，相同时选择所在线段更窄的，减少浪费的空隙
+    int bestIndex = -1;
+    int bestTop = std::numeric_limits<int>::max();
+    int bestWidth = std::numeric_limits<int>::max();
+    int bestY = 0;
+    for (size_t i = 0; i < m_skyline.size(); ++i) {
+        const int top = fit(i, width, height);
+        if (top < 0) {
+            continue;
+        }
+        if (top + height < bestTop || (top + height == bestTop && m_skyline[i].width < bestWidth)) {
+            bestIndex = static_cast<int>(i);
+            bestTop = top + height;
+            bestWidth = m_skyline[i].width;
+            bestY = top;
+        }
+    }
+    if (bestIndex < 0) {
+        return false;
+    }
+
+    x = m_skyline[bestIndex].x;
+    y = bestY;
+    m_skyline.insert(m_skyline.begin() + bestIndex, { x, bestY + height, width });
+
+    // 新线段右侧被覆盖的部分从天际线中裁掉
+    for (size_t i = bestIndex + 1; i < m_skyline.size();) {
+        const Segment& previous = m_skyline[i - 1];
+        Segment& segment = m_skyline[i];
+        const int overlap = previous.x + previous.width - segment.x;
+        if (overlap <= 0) {
+            break;
+        }
+        segment.x += overlap;
+        segment.width -= overlap;
+        if (segment.width > 0) {
+            break;
+        }
+        m_skyline.erase(m_skyline.begin() + i);
+    }
+
+    // 合并高度相同的相邻线段
+    for (size_t i = 0; i + 1 < m_skyline.size();) {
+        if (m_skyline[i].y == m_skyline[i + 1].y) {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+    return true;
+}
+
+void AtlasPacker::fill() {
+    m_skyline.clear();
+    m_skyline.push_back({ 0, m_height, m_width });
+}
+
+int AtlasPacker::fit(size_t index, int width, int height) const {
+    const int x = m_skyline[index].x;
+    if (x + width > m_width) {
+        return -1;
+    }
+
+    // 矩形跨过的所有线段中最高的一段决定放置高度
+    int y = m_skyline[index].y;
+    int remaining = width;
+    for (size_t i = index; remaining > 0; ++i) {
+        if (i >= m_skyline.size()) {
+            return -1;
+        }
+        y = std::max(y, m_skyline[i].y);
+        if (y + height > m_height) {
+            return -1;
+        }
+        remaining -= m_skyline[i].width;
+    }
+    return y;
+}
+
+TextureAtlas::TextureAtlas(int pageSize, int padding)
+    : m_pageSize(std::max(pageSize, 1))
+    , m_padding(std::max(padding, 0)) {
+}
+
+TextureAtlas::~TextureAtlas() {
+    clear();
+}
+
+bool TextureAtlas::addImage(const std::string& name, SDL_Surface* surface) {
+    if (!surface || surface->w <= 0 || surface->h <= 0) {
+        LOG_WARN("图集图像无效: " + name);
+        return false;
+    }
+    if (m_regions.count(name) || std::any_of(m_pending.begin(), m_pending.end(),
+                                             [&name](const PendingImage& image) { return image.name == name; })) {
+        LOG_WARN("图集中已存在同名图像: " + name);
+        return false;
+    }
+
+    // 统一转换为RGBA32，拷贝时不混合以保留透明通道
+    SDL_Surface* copy = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!copy) {
+        LOG_ERROR("转换图集图像失败: " + name + " " + SDL_GetError());
+        return false;
+    }
+    SDL_SetSurfaceBlendMode(copy, SDL_BLENDMODE_NONE);
+    m_pending.push_back({ name, copy });
+    return true;
+}
+
+bool TextureAtlas::pack() {
+    // 先放高的图像，天际线更平整，利用率更高
+    std::sort(m_pending.begin(), m_pending.end(), [](const PendingImage& a, const PendingImage& b) {
+        if (a.surface->h != b.surface->h) {
+            return a.surface->h > b.surface->h;
+        }
+        if (a.surface->w != b.surface->w) {
+            return a.surface->w > b.surface->w;
+        }
+        return a.name < b.name;
+    });
+
+    bool packedAll = true;
+    for (PendingImage& image : m_pending) {
+        const int width = image.surface->w + m_padding;
+        const int height = image.surface->h + m_padding;
+        if (width > m_pageSize || height > m_pageSize) {
+            LOG_WARN("图像超过图集页尺寸，未加入图集: " + image.name);
+            SDL_FreeSurface(image.surface);
+            packedAll = false;
+            continue;
+        }
+
+        int page = 0;
+        int x = 0;
+        int y = 0;
+        while (page < static_cast<int>(m_pages.size()) && !m_pages[page].packer.insert(width, height, x, y)) {
+            ++page;
+        }
+        if (page == static_cast<int>(m_pages.size())) {
+            page = addPage(nullptr);
+            if (page < 0 || !m_pages[page].packer.insert(width, height, x, y)) {
+                SDL_FreeSurface(image.surface);
+                packedAll = false;
+                continue;
+            }
+        }
+
+        AtlasRegion region;
+        region.page = page;
+        region.rect = { x, y, image.surface->w, image.surface->h };
+        SDL_Rect target = region.rect;
+        SDL_BlitSurface(image.surface, nullptr, m_pages[page].surface, &target);
+        SDL_FreeSurface(image.surface);
+
+        m_pages[page].dirty = true;
+        m_regions[image.name] = region;
+    }
+
+    m_pending.clear();
+    return packedAll;
+}
+
+bool TextureAtlas::createTextures(SDL_Renderer* renderer) {
+    if (!renderer) {
+        return false;
+    }
+
+    bool success = true;
+    for (Page& page : m_pages) {
+        if (!page.dirty) {
+            continue;
+        }
+
+        // 纹理只创建一次，之后原地更新，已分发出去的纹理指针保持有效
+        if (!page.texture) {
+            page.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                             page.surface->w, page.surface->h);
+            if (!page.texture) {
+                LOG_ERROR("创建图集纹理失败: " + std::string(SDL_GetError()));
+                success = false;
+                continue;
+            }
+            SDL_SetTextureBlendMode(page.texture, SDL_BLENDMODE_BLEND);
+        }
+        if (SDL_UpdateTexture(page.texture, nullptr, page.surface->pixels, page.surface->pitch) != 0) {
+            LOG_ERROR("上传图集纹理失败: " + std::string(SDL_GetError()));
+            success = false;
+            continue;
+        }
+        page.dirty = false;
+    }
+    return success;
+}
+
+bool TextureAtlas::save(const std::string& directory, const std::string& name) const {
+    if (!m_pending.empty()) {
+        LOG_WARN("图集中有未打包的图像，它们不会被保存");
+    }
+
+    std::ofstream file(joinPath(directory, name + ".atlas"));
+    if (!file) {
+        LOG_ERROR("无法写入图集描述文件: " + joinPath(directory, name + ".atlas"));
+        return false;
+    }
+
+    file << ATLAS_HEADER << "\n";
+    for (size_t i = 0; i < m_pages.size(); ++i) {
+        const std::string filename = name + "_" + std::to_string(i) + ".bmp";
+        if (SDL_SaveBMP(m_pages[i].surface, joinPath(directory, filename).c_str()) != 0) {
+            LOG_ERROR("无法写入图集页: " + filename + " " + SDL_GetError());
+            return false;
+        }
+        file << "page " << i << " " << filename << "\n";
+    }
+
+    // 按名称排序输出，同样的输入总是得到同样的文件
+    std::vector<const std::pair<const std::string, AtlasRegion>*> regions;
+    regions.reserve(m_regions.size());
+    for (const auto& entry : m_regions) {
+        regions.push_back(&entry);
+    }
+    std::sort(regions.begin(), regions.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+    for (const auto* entry : regions) {
+        const AtlasRegion& region = entry->second;
+        file << "region " << region.page << " " << region.rect.x << " " << region.rect.y << " "
+             << region.rect.w << " " << region.rect.h << " " << entry->first << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+bool TextureAtlas::load(SDL_Renderer* renderer, const std::string& filepath) {
+    clear();
+
+    std::ifstream file(filepath);
+    std::string line;
+    if (!file || !std::getline(file, line) || line != ATLAS_HEADER) {
+        LOG_ERROR("无效的图集描述文件: " + filepath);
+        return false;
+    }
+
+    const std::string directory = directoryOf(filepath);
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        std::string type;
+        stream >> type;
+        if (type == "page") {
+            int index = -1;
+            std::string filename;
+            stream >> index >> filename;
+            SDL_Surface* loaded = SDL_LoadBMP(joinPath(directory, filename).c_str());
+            SDL_Surface* surface = loaded ? SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0) : nullptr;
+            SDL_FreeSurface(loaded);
+            if (!surface || index != static_cast<int>(m_pages.size())) {
+                LOG_ERROR("无法读取图集页: " + filename);
+                SDL_FreeSurface(surface);
+                clear();
+                return false;
+            }
+
+            // 离线打包的页没有装箱状态，视为已占满，之后加入的图像放到新页
+            const int page = addPage(surface);
+            m_pages[page].packer.fill();
+        } else if (type == "region") {
+            // 名称放在行尾，可以包含空格
+            AtlasRegion region;
+            std::string name;
+            const bool parsed = static_cast<bool>(stream >> region.page >> region.rect.x >> region.rect.y
+                                                         >> region.rect.w >> region.rect.h) &&
+                                static_cast<bool>(std::getline(stream >> std::ws, name));
+            if (!parsed || name.empty() || region.page < 0 || region.page >= static_cast<int>(m_pages.size())) {
+                LOG_ERROR("图集描述文件中的子图无效: " + line);
+                clear();
+                return false;
+            }
+            m_regions[name] = region;
+        }
+    }
+
+    return createTextures(renderer);
+}
+
+bool TextureAtlas::getRegion(const std::string& name, AtlasRegion& region) const {
+    auto it = m_regions.find(name);
+    if (it == m_regions.end()) {
+        return false;
+    }
+    region = it->second;
+    return true;
+}
+
+SDL_Texture* TextureAtlas::getTexture(int page) const {
+    if (page < 0 || page >= static_cast<int>(m_pages.size())) {
+        return nullptr;
+    }
+    return m_pages[page].texture;
+}
+
+int TextureAtlas::getPageCount() const {
+    return static_cast<int>(m_pages.size());
+}
+
+int TextureAtlas::getRegionCount() const {
+    return static_cast<int>(m_regions.size());
+}
+
+float TextureAtlas::getOccupancy() const {
+    long long pageArea = 0;
+    long long usedArea = 0;
+    for (const Page& page : m_pages) {
+        pageArea += static_cast<long long>(page.surface->w) * page.surface->h;
+    }
+    for (const auto& entry : m_regions) {
+        usedArea += static_cast<long long>(entry.second.rect.w) * entry.second.rect.h;
+    }
+    return pageArea > 0 ? static_cast<float>(static_cast<double>(usedArea) / pageArea) : 0.0f;
+}
+
+void TextureAtlas::clear() {
+    for (Page& page : m_pages) {
+        if (page.texture) {
+            SDL_DestroyTexture(page.texture);
+        }
+        SDL_FreeSurface(page.surface);
+    }
+    for (PendingImage& image : m_pending) {
+        SDL_FreeSurface(image.surface);
+    }
+    m_pages.clear();
+    m_pending.clear();
+    m_regions.clear();
+}
+
+int TextureAtlas::addPage(SDL_Surface* surface) {
+    if (!surface) {
+        // 新建的表面像素全为0，即完全透明
+        surface = SDL_CreateRGBSurfaceWithFormat(0, m_pageSize, m_pageSize, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!surface) {
+            LOG_ERROR("创建图集页失败: " + std::string(SDL_GetError()));
+            return -1;
+        }
+    }
+
+    Page page;
+    page.surface = surface;
+    page.texture = nullptr;
+    page.packer.reset(surface->w, surface->h);
+    page.dirty = true;
+    m_pages.push_back(page);
+    return static_cast<int>(m_pages.size()) - 1;
+}
+
+} // namespace Engine2D
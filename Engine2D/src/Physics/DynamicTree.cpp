@@ -0,0 +1,465 @@
+#include "Engine2D/Physics/DynamicTree.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Engine2D {
+
+namespace {
+    // 射线段与包围盒是否相交（slab方法）
+    bool segmentOverlapsAABB(const Vector2& origin, const Vector2& inverseDirection, float maxDistance, const AABB& aabb) {
+        float t1 = (aabb.min.x - origin.x) * inverseDirection.x;
+        float t2 = (aabb.max.x - origin.x) * inverseDirection.x;
+        float tMin = std::min(t1, t2);
+        float tMax = std::max(t1, t2);
+
+        t1 = (aabb.min.y - origin.y) * inverseDirection.y;
+        t2 = (aabb.max.y - origin.y) * inverseDirection.y;
+        tMin = std::max(tMin, std::min(t1, t2));
+        tMax = std::min(tMax, std::max(t1, t2));
+
+        return tMax >= std::max(tMin, 0.0f) && tMin <= maxDistance;
+    }
+}
+
+DynamicTree::DynamicTree(float margin)
+    : m_margin(margin)
+    , m_root(NULL_NODE)
+    , m_freeList(NULL_NODE)
+    , m_proxyCount(0) {
+}
+
+DynamicTree::~DynamicTree() {
+    clear();
+}
+
+BroadphaseType DynamicTree::getType() const {
+    return BroadphaseType::DYNAMIC_TREE;
+}
+
+void DynamicTree::setMargin(float margin) {
+    m_margin = std::max(0.0f, margin);
+}
+
+float DynamicTree::getMargin() const {
+    return m_margin;
+}
+
+int DynamicTree::createProxy(const AABB& aabb, Collider* collider) {
+    int proxyId = allocateNode();
+    Node& node = m_nodes[proxyId];
+    node.aabb = aabb.expanded(m_margin);
+    node.collider = collider;
+    node.height = 0;
+
+    insertLeaf(proxyId);
+    ++m_proxyCount;
+    return proxyId;
+}
+
+void DynamicTree::destroyProxy(int proxyId) {
+    if (proxyId < 0 || proxyId >= static_cast<int>(m_nodes.size()) || m_nodes[proxyId].height != 0) {
+        return;
+    }
+
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    --m_proxyCount;
+}
+
+bool DynamicTree::moveProxy(int proxyId, const AABB& aabb) {
+    if (m_nodes[proxyId].aabb.contains(aabb)) {
+        // 仍在胖包围盒内，树结构不变
+        return false;
+    }
+
+    removeLeaf(proxyId);
+    m_nodes[proxyId].aabb = aabb.expanded(m_margin);
+    insertLeaf(proxyId);
+    return true;
+}
+
+const AABB& DynamicTree::getAABB(int proxyId) const {
+    return m_nodes[proxyId].aabb;
+}
+
+Collider* DynamicTree::getCollider(int proxyId) const {
+    return m_nodes[proxyId].collider;
+}
+
+void DynamicTree::computePairs(std::vector<BroadphasePair>& pairs) const {
+    pairs.clear();
+    if (m_root == NULL_NODE) {
+        return;
+    }
+
+    for (int leaf = 0; leaf < static_cast<int>(m_nodes.size()); ++leaf) {
+        const Node& leafNode = m_nodes[leaf];
+        if (leafNode.height != 0) {
+            continue;
+        }
+
+        m_stack.clear();
+        m_stack.push_back(m_root);
+        while (!m_stack.empty()) {
+            const int nodeId = m_stack.back();
+            m_stack.pop_back();
+
+            const Node& node = m_nodes[nodeId];
+            if (!node.aabb.overlaps(leafNode.aabb)) {
+                continue;
+            }
+
+            if (node.isLeaf()) {
+                // 每对只由ID较小的一方报告
+                if (nodeId > leaf) {
+                    pairs.emplace_back(leafNode.collider, node.collider);
+                }
+            } else {
+                m_stack.push_back(node.child1);
+                m_stack.push_back(node.child2);
+            }
+        }
+    }
+}
+
+void DynamicTree::query(const AABB& aabb, std::vector<Collider*>& results) const {
+    if (m_root == NULL_NODE) {
+        return;
+    }
+
+    m_stack.clear();
+    m_stack.push_back(m_root);
+    while (!m_stack.empty()) {
+        const int nodeId = m_stack.back();
+        m_stack.pop_back();
+
+        const Node& node = m_nodes[nodeId];
+        if (!node.aabb.overlaps(aabb)) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            results.push_back(node.collider);
+        } else {
+            m_stack.push_back(node.child1);
+            m_stack.push_back(node.child2);
+        }
+    }
+}
+
+void DynamicTree::queryProxies(const AABB& aabb, std::vector<int>& results) const {
+    if (m_root == NULL_NODE) {
+        return;
+    }
+
+    m_stack.clear();
+    m_stack.push_back(m_root);
+    while (!m_stack.empty()) {
+        const int nodeId = m_stack.back();
+        m_stack.pop_back();
+
+        const Node& node = m_nodes[nodeId];
+        if (!node.aabb.overlaps(aabb)) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            results.push_back(nodeId);
+        } else {
+            m_stack.push_back(node.child1);
+            m_stack.push_back(node.child2);
+        }
+    }
+}
+
+void DynamicTree::raycast(const Vector2& origin, const Vector2& direction, float maxDistance,
+                          const BroadphaseRaycastCallback& callback) const {
+    if (m_root == NULL_NODE) {
+        return;
+    }
+
+    // 方向分量为0时用极大值代替倒数，slab测试仍然成立
+    const Vector2 inverseDirection(direction.x != 0.0f ? 1.0f / direction.x : 1e30f,
+                                   direction.y != 0.0f ? 1.0f / direction.y : 1e30f);
+    float distance = maxDistance;
+
+    // 回调可能再次查询本树，因此射线遍历使用独立的栈
+    std::vector<int> stack;
+    stack.push_back(m_root);
+    while (!stack.empty()) {
+        const int nodeId = stack.back();
+        stack.pop_back();
+
+        const Node& node = m_nodes[nodeId];
+        if (!segmentOverlapsAABB(origin, inverseDirection, distance, node.aabb)) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            const float result = callback(node.collider);
+            if (result < 0.0f) {
+                return;
+            }
+            distance = std::min(distance, result);
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+int DynamicTree::getProxyCount() const {
+    return m_proxyCount;
+}
+
+void DynamicTree::clear() {
+    m_nodes.clear();
+    m_root = NULL_NODE;
+    m_freeList = NULL_NODE;
+    m_proxyCount = 0;
+}
+
+int DynamicTree::getHeight() const {
+    return m_root == NULL_NODE ? 0 : m_nodes[m_root].height + 1;
+}
+
+int DynamicTree::allocateNode() {
+    int nodeId;
+    if (m_freeList != NULL_NODE) {
+        nodeId = m_freeList;
+        m_freeList = m_nodes[nodeId].parent;
+    } else {
+        nodeId = static_cast<int>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+
+    Node& node = m_nodes[nodeId];
+    node.collider = nullptr;
+    node.parent = NULL_NODE;
+    node.child1 = NULL_NODE;
+    node.child2 = NULL_NODE;
+    node.height = 0;
+    return nodeId;
+}
+
+void DynamicTree::freeNode(int nodeId) {
+    Node& node = m_nodes[nodeId];
+    node.collider = nullptr;
+    node.parent = m_freeList;
+    node.height = -1;
+    m_freeList = nodeId;
+}
+
+void DynamicTree::insertLeaf(int leaf) {
+    if (m_root == NULL_NODE) {
+        m_root = leaf;
+        m_nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // 按周长代价寻找最佳兄弟节点
+    const AABB leafAABB = m_nodes[leaf].aabb;
+    int index = m_root;
+    while (!m_nodes[index].isLeaf()) {
+        const Node& node = m_nodes[index];
+        const float area = node.aabb.perimeter();
+        const float combinedArea = AABB::merge(node.aabb, leafAABB).perimeter();
+
+        // 在此处新建父节点的代价
+        const float cost = 2.0f * combinedArea;
+        // 继续下降所需承担的继承代价
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float childCosts[2];
+        const int children[2] = { node.child1, node.child2 };
+        for (int i = 0; i < 2; ++i) {
+            const Node& child = m_nodes[children[i]];
+            const float mergedArea = AABB::merge(leafAABB, child.aabb).perimeter();
+            if (child.isLeaf()) {
+                childCosts[i] = mergedArea + inheritanceCost;
+            } else {
+                childCosts[i] = (mergedArea - child.aabb.perimeter()) + inheritanceCost;
+            }
+        }
+
+        if (cost < childCosts[0] && cost < childCosts[1]) {
+            break;
+        }
+        index = childCosts[0] < childCosts[1] ? children[0] : children[1];
+    }
+
+    // 新建父节点连接兄弟节点与新叶节点
+    const int sibling = index;
+    const int oldParent = m_nodes[sibling].parent;
+    const int newParent = allocateNode();
+    m_nodes[newParent].parent = oldParent;
+    m_nodes[newParent].aabb = AABB::merge(leafAABB, m_nodes[sibling].aabb);
+    m_nodes[newParent].height = m_nodes[sibling].height + 1;
+    m_nodes[newParent].child1 = sibling;
+    m_nodes[newParent].child2 = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent != NULL_NODE) {
+        if (m_nodes[oldParent].child1 == sibling) {
+            m_nodes[oldParent].child1 = newParent;
+        } else {
+            m_nodes[oldParent].child2 = newParent;
+        }
+    } else {
+        m_root = newParent;
+    }
+
+    // 向上修正高度和包围盒
+    index = m_nodes[leaf].parent;
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        const int child1 = m_nodes[index].child1;
+        const int child2 = m_nodes[index].child2;
+        m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+        m_nodes[index].aabb = AABB::merge(m_nodes[child1].aabb, m_nodes[child2].aabb);
+
+        index = m_nodes[index].parent;
+    }
+}
+
+void DynamicTree::removeLeaf(int leaf) {
+    if (leaf == m_root) {
+        m_root = NULL_NODE;
+        return;
+    }
+
+    const int parent = m_nodes[leaf].parent;
+    const int grandParent = m_nodes[parent].parent;
+    const int sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grandParent != NULL_NODE) {
+        // 用兄弟节点替换父节点
+        if (m_nodes[grandParent].child1 == parent) {
+            m_nodes[grandParent].child1 = sibling;
+        } else {
+            m_nodes[grandParent].child2 = sibling;
+        }
+        m_nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        int index = grandParent;
+        while (index != NULL_NODE) {
+            index = balance(index);
+
+            const int child1 = m_nodes[index].child1;
+            const int child2 = m_nodes[index].child2;
+            m_nodes[index].aabb = AABB::merge(m_nodes[child1].aabb, m_nodes[child2].aabb);
+            m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+
+            index = m_nodes[index].parent;
+        }
+    } else {
+        m_root = sibling;
+        m_nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+    }
+}
+
+int DynamicTree::balance(int iA) {
+    Node& A = m_nodes[iA];
+    if (A.isLeaf() || A.height < 2) {
+        return iA;
+    }
+
+    const int iB = A.child1;
+    const int iC = A.child2;
+    Node& B = m_nodes[iB];
+    Node& C = m_nodes[iC];
+
+    const int heightBalance = C.height - B.height;
+
+    // 右子树过高，将C提升为根
+    if (heightBalance > 1) {
+        const int iF = C.child1;
+        const int iG = C.child2;
+        Node& F = m_nodes[iF];
+        Node& G = m_nodes[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+
+        if (C.parent != NULL_NODE) {
+            if (m_nodes[C.parent].child1 == iA) {
+                m_nodes[C.parent].child1 = iC;
+            } else {
+                m_nodes[C.parent].child2 = iC;
+            }
+        } else {
+            m_root = iC;
+        }
+
+        if (F.height > G.height) {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.aabb = AABB::merge(B.aabb, G.aabb);
+            C.aabb = AABB::merge(A.aabb, F.aabb);
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        } else {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.aabb = AABB::merge(B.aabb, F.aabb);
+            C.aabb = AABB::merge(A.aabb, G.aabb);
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+
+        return iC;
+    }
+
+    // 左子树过高，将B提升为根
+    if (heightBalance < -1) {
+        const int iD = B.child1;
+        const int iE = B.child2;
+        Node& D = m_nodes[iD];
+        Node& E = m_nodes[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+
+        if (B.parent != NULL_NODE) {
+            if (m_nodes[B.parent].child1 == iA) {
+                m_nodes[B.parent].child1 = iB;
+            } else {
+                m_nodes[B.parent].child2 = iB;
+            }
+        } else {
+            m_root = iB;
+        }
+
+        if (D.height > E.height) {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.aabb = AABB::merge(C.aabb, E.aabb);
+            B.aabb = AABB::merge(A.aabb, D.aabb);
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        } else {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.aabb = AABB::merge(C.aabb, D.aabb);
+            B.aabb = AABB::merge(A.aabb, E.aabb);
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+
+        return iB;
+    }
+
+    return iA;
+}
+
+} // namespace Engine2D
@@ -0,0 +1,671 @@
+#include "Engine2D/Physics/Narrowphase.h"
+#include "Engine2D/Physics/Collider.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Engine2D {
+
+namespace {
+    const float RELATIVE_TOLERANCE = 0.98f;   // 两侧分离量接近时优先选A的边作为参考边，避免参考边逐帧来回切换
+    const float ABSOLUTE_TOLERANCE = 0.001f;  // 参考边选择的绝对容差
+
+    // 裁剪用的顶点，附带特征编号
+    struct ClipVertex {
+        Vector2 position;
+        int id;
+    };
+
+    // 对瓦片地图中与扫掠范围重叠的每个矩形做投射，取最近的命中
+    template <typename Cast>
+    bool castTilemap(const TilemapCollider& tilemap, const Vector2& extents, const Vector2& origin,
+                     const Vector2& direction, float maxDistance, float& distance, Vector2& normal, Cast cast) {
+        const Vector2 end = origin + direction * maxDistance;
+        const AABB swept(Vector2(std::min(origin.x, end.x) - extents.x, std::min(origin.y, end.y) - extents.y),
+                         Vector2(std::max(origin.x, end.x) + extents.x, std::max(origin.y, end.y) + extents.y));
+        bool hit = false;
+        tilemap.forEachRect(swept, [&](int index) {
+            ColliderShape rect;
+            tilemap.buildRectShape(index, rect);
+            float rectDistance;
+            Vector2 rectNormal;
+            if (cast(rect, maxDistance, rectDistance, rectNormal)) {
+                maxDistance = rectDistance;
+                distance = rectDistance;
+                normal = rectNormal;
+                hit = true;
+            }
+        });
+        return hit;
+    }
+
+    // 按旋转角度旋转向量
+    Vector2 rotate(const Vector2& v, float cosine, float sine) {
+        return Vector2(cosine * v.x - sine * v.y, sine * v.x + cosine * v.y);
+    }
+
+    // 求A的所有边法线上B的最大分离量：B沿法线反方向的支撑点就是最深的点
+    float findMaxSeparation(const PolygonShape& a, const PolygonShape& b, int& edge) {
+        float maxSeparation = -std::numeric_limits<float>::max();
+        edge = 0;
+        for (int i = 0; i < a.count; ++i) {
+            const Vector2& support = b.vertices[b.getSupport(a.normals[i] * -1.0f)];
+            const float separation = a.normals[i].dot(support - a.vertices[i]);
+            if (separation > maxSeparation) {
+                maxSeparation = separation;
+                edge = i;
+                if (separation > 0.0f) {
+                    // 已找到分离轴，不需要再比较其余边
+                    break;
+                }
+            }
+        }
+        return maxSeparation;
+    }
+
+    // 用直线 normal·x = offset 裁剪线段，保留 normal·x <= offset 的部分
+    int clipSegment(const ClipVertex input[2], ClipVertex output[2], const Vector2& normal, float offset, int clipId) {
+        int count = 0;
+        const float distance0 = normal.dot(input[0].position) - offset;
+        const float distance1 = normal.dot(input[1].position) - offset;
+
+        if (distance0 <= 0.0f) {
+            output[count++] = input[0];
+        }
+        if (distance1 <= 0.0f) {
+            output[count++] = input[1];
+        }
+        if (distance0 * distance1 < 0.0f) {
+            const float t = distance0 / (distance0 - distance1);
+            output[count].position = input[0].position + (input[1].position - input[0].position) * t;
+            output[count].id = clipId;
+            ++count;
+        }
+        return count;
+    }
+}
+
+AABB PolygonShape::getAABB() const {
+    AABB aabb(vertices[0], vertices[0]);
+    for (int i = 1; i < count; ++i) {
+        aabb.min.x = std::min(aabb.min.x, vertices[i].x);
+        aabb.min.y = std::min(aabb.min.y, vertices[i].y);
+        aabb.max.x = std::max(aabb.max.x, vertices[i].x);
+        aabb.max.y = std::max(aabb.max.y, vertices[i].y);
+    }
+    return aabb;
+}
+
+int PolygonShape::getSupport(const Vector2& direction) const {
+    int best = 0;
+    float bestProjection = vertices[0].dot(direction);
+    for (int i = 1; i < count; ++i) {
+        const float projection = vertices[i].dot(direction);
+        if (projection > bestProjection) {
+            bestProjection = projection;
+            best = i;
+        }
+    }
+    return best;
+}
+
+void makeBoxShape(const Vector2& center, float halfWidth, float halfHeight, float rotation, PolygonShape& shape) {
+    static const Vector2 corners[4] = {
+        Vector2(-1.0f, -1.0f), Vector2(1.0f, -1.0f), Vector2(1.0f, 1.0f), Vector2(-1.0f, 1.0f)
+    };
+    static const Vector2 normals[4] = {
+        Vector2(0.0f, -1.0f), Vector2(1.0f, 0.0f), Vector2(0.0f, 1.0f), Vector2(-1.0f, 0.0f)
+    };
+
+    const float cosine = std::cos(rotation);
+    const float sine = std::sin(rotation);
+    shape.count = 4;
+    shape.centroid = center;
+    for (int i = 0; i < 4; ++i) {
+        shape.vertices[i] = center + rotate(Vector2(corners[i].x * halfWidth, corners[i].y * halfHeight), cosine, sine);
+        shape.normals[i] = rotate(normals[i], cosine, sine);
+    }
+}
+
+void transformPolygon(const Vector2* localVertices, const Vector2* localNormals, int count,
+                      const Vector2& position, float rotation, const Vector2& scale, PolygonShape& shape) {
+    const float cosine = std::cos(rotation);
+    const float sine = std::sin(rotation);
+    const bool uniformScale = scale.x == scale.y;
+
+    shape.count = std::min(count, static_cast<int>(PolygonShape::MAX_VERTICES));
+    shape.centroid = Vector2();
+    for (int i = 0; i < shape.count; ++i) {
+        shape.vertices[i] = position + rotate(Vector2(localVertices[i].x * scale.x, localVertices[i].y * scale.y), cosine, sine);
+        shape.centroid = shape.centroid + shape.vertices[i];
+
+        // 均匀缩放时法线只需旋转；非均匀缩放按逆转置变换后重新归一化
+        if (uniformScale) {
+            shape.normals[i] = rotate(localNormals[i], cosine, sine);
+        } else {
+            shape.normals[i] = rotate(Vector2(localNormals[i].x / scale.x, localNormals[i].y / scale.y), cosine, sine).normalized();
+        }
+    }
+    if (shape.count > 0) {
+        shape.centroid = shape.centroid / static_cast<float>(shape.count);
+    }
+}
+
+int computeConvexHull(Vector2* points, int count, Vector2* hull) {
+    std::sort(points, points + count, [](const Vector2& a, const Vector2& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+
+    auto turn = [](const Vector2& o, const Vector2& a, const Vector2& b) {
+        return (a - o).cross(b - o);
+    };
+
+    // 先求下半凸包，再反向求上半凸包
+    int size = 0;
+    for (int i = 0; i < count; ++i) {
+        while (size >= 2 && turn(hull[size - 2], hull[size - 1], points[i]) <= 0.0f) {
+            --size;
+        }
+        hull[size++] = points[i];
+    }
+    for (int i = count - 2, lower = size + 1; i >= 0; --i) {
+        while (size >= lower && turn(hull[size - 2], hull[size - 1], points[i]) <= 0.0f) {
+            --size;
+        }
+        hull[size++] = points[i];
+    }
+
+    // 最后一个点与第一个点重复
+    return std::max(0, size - 1);
+}
+
+bool isOrientedBox(const Collider* collider) {
+    if (collider->getType() != ColliderType::BOX) {
+        return false;
+    }
+    const Transform* transform = collider->getTransform();
+    return transform && transform->getRotation() != 0.0f;
+}
+
+void makeBoxShape(const BoxShape& box, PolygonShape& shape) {
+    makeBoxShape(box.center, box.halfExtents.x, box.halfExtents.y, box.rotation, shape);
+}
+
+void buildColliderShape(const Collider* collider, ColliderShape& shape) {
+    shape.type = collider->getType();
+    switch (shape.type) {
+        case ColliderType::CIRCLE: {
+            auto circle = static_cast<const CircleCollider*>(collider);
+            shape.circle.center = circle->getCenter();
+            shape.circle.radius = circle->getRadius();
+            break;
+        }
+        case ColliderType::POLYGON:
+            shape.polygon = &static_cast<const PolygonCollider*>(collider)->getWorldShape();
+            break;
+        case ColliderType::BOX: {
+            auto box = static_cast<const BoxCollider*>(collider);
+            const Transform* transform = box->getTransform();
+            shape.box.center = box->getCenter();
+            shape.box.halfExtents = Vector2(box->getWidth() * 0.5f, box->getHeight() * 0.5f);
+            shape.box.rotation = transform ? transform->getRotation() : 0.0f;
+            break;
+        }
+        case ColliderType::TILEMAP:
+            shape.tilemap = static_cast<const TilemapCollider*>(collider);
+            break;
+    }
+}
+
+bool collideAlignedBoxes(const BoxShape& a, const BoxShape& b, ContactPoints& contact) {
+    const Vector2 offset = b.center - a.center;
+    const float overlapX = a.halfExtents.x + b.halfExtents.x - std::fabs(offset.x);
+    const float overlapY = a.halfExtents.y + b.halfExtents.y - std::fabs(offset.y);
+    if (overlapX <= 0.0f || overlapY <= 0.0f) {
+        return false;
+    }
+
+    // 沿重叠较小的轴分离，接触点取另一轴上重叠区间的两端，使堆叠的物体受力平衡；
+    // 编号按坐标从小到大分配，与法线方向无关，便于跨帧匹配
+    const Vector2 minA = a.center - a.halfExtents;
+    const Vector2 maxA = a.center + a.halfExtents;
+    const Vector2 minB = b.center - b.halfExtents;
+    const Vector2 maxB = b.center + b.halfExtents;
+    if (overlapX < overlapY) {
+        const float x = (std::max(minA.x, minB.x) + std::min(maxA.x, maxB.x)) * 0.5f;
+        contact.normal = Vector2(offset.x < 0.0f ? -1.0f : 1.0f, 0.0f);
+        contact.points[0] = Vector2(x, std::max(minA.y, minB.y));
+        contact.points[1] = Vector2(x, std::min(maxA.y, maxB.y));
+        contact.penetrations[0] = overlapX;
+        contact.penetrations[1] = overlapX;
+    } else {
+        const float y = (std::max(minA.y, minB.y) + std::min(maxA.y, maxB.y)) * 0.5f;
+        contact.normal = Vector2(0.0f, offset.y < 0.0f ? -1.0f : 1.0f);
+        contact.points[0] = Vector2(std::max(minA.x, minB.x), y);
+        contact.points[1] = Vector2(std::min(maxA.x, maxB.x), y);
+        contact.penetrations[0] = overlapY;
+        contact.penetrations[1] = overlapY;
+    }
+    contact.ids[0] = 0;
+    contact.ids[1] = 1;
+
+    const Vector2 span = contact.points[1] - contact.points[0];
+    contact.pointCount = span.dot(span) > 1e-6f ? 2 : 1;
+    return true;
+}
+
+bool collidePolygons(const PolygonShape& a, const PolygonShape& b, ContactPoints& contact) {
+    int edgeA;
+    const float separationA = findMaxSeparation(a, b, edgeA);
+    if (separationA > 0.0f) {
+        return false;
+    }
+
+    int edgeB;
+    const float separationB = findMaxSeparation(b, a, edgeB);
+    if (separationB > 0.0f) {
+        return false;
+    }
+
+    // 分离量最大（穿透最浅）的一侧提供参考边
+    const bool flip = separationB > RELATIVE_TOLERANCE * separationA + ABSOLUTE_TOLERANCE;
+    const PolygonShape& reference = flip ? b : a;
+    const PolygonShape& incident = flip ? a : b;
+    const int referenceEdge = flip ? edgeB : edgeA;
+    const Vector2& referenceNormal = reference.normals[referenceEdge];
+
+    // 入射边是法线与参考法线最反向的边
+    int incidentEdge = 0;
+    float minDot = std::numeric_limits<float>::max();
+    for (int i = 0; i < incident.count; ++i) {
+        const float d = referenceNormal.dot(incident.normals[i]);
+        if (d < minDot) {
+            minDot = d;
+            incidentEdge = i;
+        }
+    }
+
+    ClipVertex incidentVertices[2];
+    incidentVertices[0].position = incident.vertices[incidentEdge];
+    incidentVertices[0].id = incidentEdge;
+    incidentVertices[1].position = incident.vertices[(incidentEdge + 1) % incident.count];
+    incidentVertices[1].id = (incidentEdge + 1) % incident.count;
+
+    // 用参考边两端的侧面裁剪入射边
+    const Vector2& v1 = reference.vertices[referenceEdge];
+    const Vector2& v2 = reference.vertices[(referenceEdge + 1) % reference.count];
+    const Vector2 tangent = (v2 - v1).normalized();
+
+    ClipVertex clipped1[2];
+    if (clipSegment(incidentVertices, clipped1, tangent * -1.0f, -tangent.dot(v1), 0x80) < 2) {
+        return false;
+    }
+    ClipVertex clipped2[2];
+    if (clipSegment(clipped1, clipped2, tangent, tangent.dot(v2), 0x81) < 2) {
+        return false;
+    }
+
+    // 保留位于参考边内侧的点，接触点取两侧表面的中点
+    const float frontOffset = referenceNormal.dot(v1);
+    const int featureBase = (referenceEdge << 8) | (flip ? 0x10000 : 0);
+    contact.pointCount = 0;
+    for (int i = 0; i < 2; ++i) {
+        const float separation = referenceNormal.dot(clipped2[i].position) - frontOffset;
+        if (separation <= 0.0f) {
+            const int index = contact.pointCount++;
+            contact.points[index] = clipped2[i].position - referenceNormal * (separation * 0.5f);
+            contact.penetrations[index] = -separation;
+            contact.ids[index] = featureBase | clipped2[i].id;
+        }
+    }
+    contact.normal = flip ? referenceNormal * -1.0f : referenceNormal;
+    return contact.pointCount > 0;
+}
+
+bool collidePolygonCircle(const PolygonShape& a, const CircleShape& b, ContactPoints& contact) {
+    // 找圆心分离量最大的边
+    int edge = 0;
+    float maxSeparation = -std::numeric_limits<float>::max();
+    for (int i = 0; i < a.count; ++i) {
+        const float separation = a.normals[i].dot(b.center - a.vertices[i]);
+        if (separation > b.radius) {
+            return false;
+        }
+        if (separation > maxSeparation) {
+            maxSeparation = separation;
+            edge = i;
+        }
+    }
+
+    const Vector2& v1 = a.vertices[edge];
+    const Vector2& v2 = a.vertices[(edge + 1) % a.count];
+    contact.pointCount = 1;
+    contact.ids[0] = 0;
+
+    if (maxSeparation < 1e-6f) {
+        // 圆心在多边形内部
+        contact.normal = a.normals[edge];
+        contact.points[0] = b.center - contact.normal * maxSeparation;
+        contact.penetrations[0] = b.radius - maxSeparation;
+        return true;
+    }
+
+    // 圆心位于边外侧：按顶点区域或边区域计算最近点
+    const float u1 = (b.center - v1).dot(v2 - v1);
+    const float u2 = (b.center - v2).dot(v1 - v2);
+    Vector2 closest;
+    if (u1 <= 0.0f) {
+        closest = v1;
+    } else if (u2 <= 0.0f) {
+        closest = v2;
+    } else {
+        contact.normal = a.normals[edge];
+        contact.points[0] = b.center - contact.normal * maxSeparation;
+        contact.penetrations[0] = b.radius - maxSeparation;
+        return true;
+    }
+
+    const Vector2 offset = b.center - closest;
+    const float distanceSquared = offset.dot(offset);
+    if (distanceSquared > b.radius * b.radius) {
+        return false;
+    }
+    const float distance = std::sqrt(distanceSquared);
+    contact.normal = distance > 0.0f ? offset / distance : a.normals[edge];
+    contact.points[0] = closest;
+    contact.penetrations[0] = b.radius - distance;
+    return true;
+}
+
+bool collideCircles(const CircleShape& a, const CircleShape& b, ContactPoints& contact) {
+    const Vector2 offset = b.center - a.center;
+    const float radius = a.radius + b.radius;
+    const float distanceSquared = offset.dot(offset);
+    if (distanceSquared > radius * radius) {
+        return false;
+    }
+
+    const float distance = std::sqrt(distanceSquared);
+    contact.normal = distance > 0.0f ? offset / distance : Vector2(0.0f, 1.0f);
+    contact.penetrations[0] = radius - distance;
+    contact.points[0] = a.center + contact.normal * (a.radius - contact.penetrations[0] * 0.5f);
+    contact.ids[0] = 0;
+    contact.pointCount = 1;
+    return true;
+}
+
+bool raycastPolygon(const PolygonShape& shape, const Vector2& origin, const Vector2& direction,
+                    float maxDistance, float& distance, Vector2& normal) {
+    // 逐条边收缩射线参数区间 [lower, upper]
+    float lower = 0.0f;
+    float upper = maxDistance;
+    int index = -1;
+
+    for (int i = 0; i < shape.count; ++i) {
+        const float numerator = shape.normals[i].dot(shape.vertices[i] - origin);
+        const float denominator = shape.normals[i].dot(direction);
+
+        if (denominator == 0.0f) {
+            // 射线与边平行且位于外侧
+            if (numerator < 0.0f) {
+                return false;
+            }
+        } else if (denominator < 0.0f && numerator < lower * denominator) {
+            // 从外侧进入该边的半平面
+            lower = numerator / denominator;
+            index = i;
+        } else if (denominator > 0.0f && numerator < upper * denominator) {
+            // 从该边的半平面离开
+            upper = numerator / denominator;
+        }
+
+        if (upper < lower) {
+            return false;
+        }
+    }
+
+    distance = lower;
+    normal = index >= 0 ? shape.normals[index] : Vector2();
+    return true;
+}
+
+bool raycastCircle(const CircleShape& shape, const Vector2& origin, const Vector2& direction,
+                   float maxDistance, float& distance, Vector2& normal) {
+    const Vector2 toOrigin = origin - shape.center;
+    const float b = toOrigin.dot(direction);
+    const float c = toOrigin.dot(toOrigin) - shape.radius * shape.radius;
+    if (c > 0.0f && b > 0.0f) {
+        return false;
+    }
+
+    const float discriminant = b * b - c;
+    if (discriminant < 0.0f) {
+        return false;
+    }
+
+    const float t = std::max(0.0f, -b - std::sqrt(discriminant));
+    if (t > maxDistance) {
+        return false;
+    }
+
+    distance = t;
+    normal = (origin + direction * t - shape.center).normalized();
+    return true;
+}
+
+bool raycastRoundedPolygon(const Vector2* vertices, int count, float radius, const Vector2& origin,
+                           const Vector2& direction, float maxDistance, float& distance, Vector2& normal) {
+    if (count == 1) {
+        CircleShape circle;
+        circle.center = vertices[0];
+        circle.radius = radius;
+        return raycastCircle(circle, origin, direction, maxDistance, distance, normal);
+    }
+
+    // 起点在圆角多边形内部：在多边形内，或到最近边的距离不超过半径（两个顶点时为线段，只看距离）
+    float maxSeparation = -std::numeric_limits<float>::max();
+    float minDistanceSquared = std::numeric_limits<float>::max();
+    for (int i = 0; i < count; ++i) {
+        const Vector2& a = vertices[i];
+        const Vector2 edge = vertices[(i + 1) % count] - a;
+        const Vector2 edgeNormal = Vector2(edge.y, -edge.x).normalized();
+        maxSeparation = std::max(maxSeparation, edgeNormal.dot(origin - a));
+
+        const float t = std::max(0.0f, std::min(1.0f, (origin - a).dot(edge) / std::max(edge.dot(edge), 1e-12f)));
+        const Vector2 offset = origin - (a + edge * t);
+        minDistanceSquared = std::min(minDistanceSquared, offset.dot(offset));
+    }
+    if ((count >= 3 && maxSeparation <= 0.0f) || minDistanceSquared <= radius * radius) {
+        distance = 0.0f;
+        normal = Vector2();
+        return true;
+    }
+
+    // 边界由外移radius的各条边和以顶点为圆心的圆弧组成，取最早进入的一段
+    bool hit = false;
+    float closest = maxDistance;
+    for (int i = 0; i < count; ++i) {
+        const Vector2& a = vertices[i];
+        const Vector2 edge = vertices[(i + 1) % count] - a;
+        const Vector2 edgeNormal = Vector2(edge.y, -edge.x).normalized();
+        const float denominator = edgeNormal.dot(direction);
+        if (denominator >= 0.0f) {
+            continue;
+        }
+
+        const float t = (edgeNormal.dot(a - origin) + radius) / denominator;
+        if (t < 0.0f || t > closest) {
+            continue;
+        }
+        const float along = (origin + direction * t - a).dot(edge);
+        if (along < 0.0f || along > edge.dot(edge)) {
+            continue;
+        }
+        closest = t;
+        normal = edgeNormal;
+        hit = true;
+    }
+
+    if (radius > 0.0f) {
+        CircleShape corner;
+        corner.radius = radius;
+        for (int i = 0; i < count; ++i) {
+            corner.center = vertices[i];
+            float cornerDistance;
+            Vector2 cornerNormal;
+            if (raycastCircle(corner, origin, direction, closest, cornerDistance, cornerNormal) && cornerDistance < closest) {
+                closest = cornerDistance;
+                normal = cornerNormal;
+                hit = true;
+            }
+        }
+    }
+
+    if (hit) {
+        distance = closest;
+    }
+    return hit;
+}
+
+bool circleCastShape(const ColliderShape& shape, float radius, const Vector2& origin, const Vector2& direction,
+                     float maxDistance, float& distance, Vector2& normal) {
+    switch (shape.type) {
+        case ColliderType::CIRCLE: {
+            CircleShape expanded = shape.circle;
+            expanded.radius += radius;
+            return raycastCircle(expanded, origin, direction, maxDistance, distance, normal);
+        }
+        case ColliderType::POLYGON:
+            return raycastRoundedPolygon(shape.polygon->vertices, shape.polygon->count, radius,
+                                         origin, direction, maxDistance, distance, normal);
+        case ColliderType::TILEMAP:
+            return castTilemap(*shape.tilemap, Vector2(radius, radius), origin, direction, maxDistance, distance, normal,
+                               [&](const ColliderShape& rect, float limit, float& rectDistance, Vector2& rectNormal) {
+                return circleCastShape(rect, radius, origin, direction, limit, rectDistance, rectNormal);
+            });
+        case ColliderType::BOX:
+            break;
+    }
+
+    PolygonShape polygon;
+    makeBoxShape(shape.box, polygon);
+    return raycastRoundedPolygon(polygon.vertices, polygon.count, radius, origin, direction, maxDistance, distance, normal);
+}
+
+bool boxCastShape(const ColliderShape& shape, const Vector2& halfExtents, const Vector2& origin,
+                  const Vector2& direction, float maxDistance, float& distance, Vector2& normal) {
+    // 目标的顶点与投射矩形的四个角逐一相加，凸包即为闵可夫斯基和（矩形关于中心对称）
+    Vector2 targetVertices[PolygonShape::MAX_VERTICES];
+    int targetCount = 0;
+    float radius = 0.0f;
+    switch (shape.type) {
+        case ColliderType::CIRCLE:
+            targetVertices[targetCount++] = shape.circle.center;
+            radius = shape.circle.radius;
+            break;
+        case ColliderType::POLYGON:
+            targetCount = shape.polygon->count;
+            std::copy(shape.polygon->vertices, shape.polygon->vertices + targetCount, targetVertices);
+            break;
+        case ColliderType::BOX: {
+            PolygonShape polygon;
+            makeBoxShape(shape.box, polygon);
+            targetCount = polygon.count;
+            std::copy(polygon.vertices, polygon.vertices + targetCount, targetVertices);
+            break;
+        }
+        case ColliderType::TILEMAP:
+            return castTilemap(*shape.tilemap, halfExtents, origin, direction, maxDistance, distance, normal,
+                               [&](const ColliderShape& rect, float limit, float& rectDistance, Vector2& rectNormal) {
+                return boxCastShape(rect, halfExtents, origin, direction, limit, rectDistance, rectNormal);
+            });
+    }
+
+    Vector2 sums[PolygonShape::MAX_VERTICES * 4];
+    int sumCount = 0;
+    for (int i = 0; i < targetCount; ++i) {
+        sums[sumCount++] = targetVertices[i] + Vector2(-halfExtents.x, -halfExtents.y);
+        sums[sumCount++] = targetVertices[i] + Vector2(halfExtents.x, -halfExtents.y);
+        sums[sumCount++] = targetVertices[i] + Vector2(halfExtents.x, halfExtents.y);
+        sums[sumCount++] = targetVertices[i] + Vector2(-halfExtents.x, halfExtents.y);
+    }
+
+    Vector2 hull[PolygonShape::MAX_VERTICES * 8];
+    const int hullCount = computeConvexHull(sums, sumCount, hull);
+    if (hullCount < 1) {
+        return false;
+    }
+    return raycastRoundedPolygon(hull, hullCount, radius, origin, direction, maxDistance, distance, normal);
+}
+
+bool containsPoint(const ColliderShape& shape, const Vector2& point) {
+    PolygonShape box;
+    const PolygonShape* polygon = shape.polygon;
+    switch (shape.type) {
+        case ColliderType::CIRCLE: {
+            const Vector2 offset = point - shape.circle.center;
+            return offset.dot(offset) <= shape.circle.radius * shape.circle.radius;
+        }
+        case ColliderType::POLYGON:
+            break;
+        case ColliderType::BOX:
+            makeBoxShape(shape.box, box);
+            polygon = &box;
+            break;
+        case ColliderType::TILEMAP:
+            return shape.tilemap->containsPoint(point);
+    }
+
+    // 凸多边形：点位于所有边的内侧
+    for (int i = 0; i < polygon->count; ++i) {
+        if (polygon->normals[i].dot(point - polygon->vertices[i]) > 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+AABB computeShapeAABB(const ColliderShape& shape) {
+    switch (shape.type) {
+        case ColliderType::CIRCLE: {
+            const Vector2 extents(shape.circle.radius, shape.circle.radius);
+            return AABB(shape.circle.center - extents, shape.circle.center + extents);
+        }
+        case ColliderType::POLYGON:
+            return shape.polygon->getAABB();
+        case ColliderType::TILEMAP: {
+            AABB aabb;
+            shape.tilemap->getBoundingBox(aabb.min, aabb.max);
+            return aabb;
+        }
+        case ColliderType::BOX:
+            break;
+    }
+
+    if (shape.box.rotation == 0.0f) {
+        return AABB(shape.box.center - shape.box.halfExtents, shape.box.center + shape.box.halfExtents);
+    }
+    PolygonShape polygon;
+    makeBoxShape(shape.box, polygon);
+    return polygon.getAABB();
+}
+
+bool raycastShape(const ColliderShape& shape, const Vector2& origin, const Vector2& direction,
+                  float maxDistance, float& distance, Vector2& normal) {
+    switch (shape.type) {
+        case ColliderType::CIRCLE:
+            return raycastCircle(shape.circle, origin, direction, maxDistance, distance, normal);
+        case ColliderType::POLYGON:
+            return raycastPolygon(*shape.polygon, origin, direction, maxDistance, distance, normal);
+        case ColliderType::TILEMAP:
+            return shape.tilemap->raycast(origin, direction, maxDistance, distance, normal);
+        case ColliderType::BOX:
+            break;
+    }
+
+    PolygonShape polygon;
+    makeBoxShape(shape.box, polygon);
+    return raycastPolygon(polygon, origin, direction, maxDistance, distance, normal);
+}
+
+} // namespace Engine2D
@@ -0,0 +1,497 @@
+#include "Engine2D/Physics/ParticleSystem.h"
+#include "Engine2D/Physics/PhysicsWorld.h"
+#include "Engine2D/Physics/Collider.h"
+#include "Engine2D/Graphics/Camera.h"
+#include "Engine2D/Graphics/Sprite.h"
+#include "Engine2D/Graphics/SpriteBatch.h"
+#include "Engine2D/Core/Engine.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Engine2D {
+
+namespace {
+    const float COLLISION_SKIN = 0.01f;     // 碰撞后停在表面外的距离，避免下一帧从内部出发
+    const float MIN_LIFETIME = 0.001f;      // 寿命下限，避免插值时除以0
+    const float STATIC_GRID_CELL_SIZE = 64.0f;  // 静态形状分桶网格的目标单元大小
+    const int MAX_STATIC_GRID_SIZE = 128;       // 分桶网格每个方向的最大单元数
+    const int MIN_SHAPES_FOR_GRID = 16;         // 形状少于此数时直接逐个测试，分桶的开销不划算
+
+    // 坐标所在的网格单元，超出网格的坐标归入边缘单元
+    int gridCell(float value, float origin, float inverseCellSize, int cellCount) {
+        const int cell = static_cast<int>((value - origin) * inverseCellSize);
+        return std::max(0, std::min(cell, cellCount - 1));
+    }
+
+    // 颜色通道插值
+    Uint8 lerpChannel(uint8_t from, uint8_t to, float t) {
+        return static_cast<Uint8>(from + (static_cast<float>(to) - from) * t);
+    }
+}
+
+ParticleSystem::ParticleSystem(int maxParticles)
+    : m_maxParticles(0)
+    , m_gravityScale(1.0f)
+    , m_drag(0.0f)
+    , m_collisionEnabled(false)
+    , m_collisionLayerMask(0xFFFFFFFFu)
+    , m_restitution(0.3f)
+    , m_sprite(nullptr)
+    , m_blendMode(SDL_BLENDMODE_BLEND)
+    , m_random(std::random_device()()) {
+    setName("ParticleSystem");
+    setMaxParticles(maxParticles);
+}
+
+ParticleSystem::~ParticleSystem() {
+}
+
+void ParticleSystem::update(float deltaTime) {
+    Component::update(deltaTime);
+    if (deltaTime <= 0.0f) {
+        return;
+    }
+
+    PhysicsWorld* world = Engine::getInstance().getPhysicsWorld();
+    integrate(deltaTime, world ? world->getGravity() : Vector2());
+    if (m_collisionEnabled && world) {
+        collideStatic(deltaTime);
+    }
+    removeExpired();
+
+    for (int i = 0; i < static_cast<int>(m_emitters.size()); ++i) {
+        Emitter& emitter = m_emitters[i];
+        if (!emitter.enabled || emitter.config.rate <= 0.0f) {
+            continue;
+        }
+        emitter.accumulator += emitter.config.rate * deltaTime;
+        const int count = static_cast<int>(emitter.accumulator);
+        emitter.accumulator -= count;
+        spawn(i, count);
+    }
+}
+
+void ParticleSystem::render() {
+    const int count = m_particles.count;
+    Renderer* renderer = Engine::getInstance().getRenderer();
+    if (count == 0 || !renderer || !renderer->getSDLRenderer()) {
+        return;
+    }
+
+    Camera* camera = renderer->getCamera();
+    const float zoom = camera ? camera->getZoom() : 1.0f;
+
+    // 有贴图时按源矩形计算纹理坐标，否则绘制纯色方块
+    SDL_Texture* texture = m_sprite && m_sprite->isValid() ? m_sprite->getTexture() : nullptr;
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+    if (texture) {
+        int textureWidth = 0;
+        int textureHeight = 0;
+        SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight);
+        const SDL_Rect& source = m_sprite->getSourceRect();
+        if (textureWidth > 0 && textureHeight > 0 && source.w > 0 && source.h > 0) {
+            u0 = static_cast<float>(source.x) / textureWidth;
+            v0 = static_cast<float>(source.y) / textureHeight;
+            u1 = static_cast<float>(source.x + source.w) / textureWidth;
+            v1 = static_cast<float>(source.y + source.h) / textureHeight;
+        }
+    }
+
+    m_vertices.resize(count * 4);
+    for (int i = 0; i < count; ++i) {
+        const ParticleEmitterConfig& config = m_emitters[m_particles.emitters[i]].config;
+        const float t = std::min(m_particles.ages[i] / m_particles.lifetimes[i], 1.0f);
+        const float halfSize = (config.startSize + (config.endSize - config.startSize) * t) * 0.5f * zoom;
+        const SDL_Color color = {
+            lerpChannel(config.startColor.r, config.endColor.r, t),
+            lerpChannel(config.startColor.g, config.endColor.g, t),
+            lerpChannel(config.startColor.b, config.endColor.b, t),
+            lerpChannel(config.startColor.a, config.endColor.a, t)
+        };
+
+        const Vector2 position(m_particles.positionsX[i], m_particles.positionsY[i]);
+        const Vector2 center = camera ? camera->worldToScreen(position) : position;
+
+        SDL_Vertex* quad = &m_vertices[i * 4];
+        quad[0] = { { center.x - halfSize, center.y - halfSize }, color, { u0, v0 } };
+        quad[1] = { { center.x + halfSize, center.y - halfSize }, color, { u1, v0 } };
+        quad[2] = { { center.x + halfSize, center.y + halfSize }, color, { u1, v1 } };
+        quad[3] = { { center.x - halfSize, center.y + halfSize }, color, { u0, v1 } };
+    }
+
+    // 粒子直接提交几何体，先画出之前排队的精灵，保持与提交顺序一致的遮挡关系
+    if (SpriteBatch* batch = Engine::getInstance().getSpriteBatch()) {
+        batch->flush();
+    }
+
+    SDL_Renderer* sdlRenderer = renderer->getSDLRenderer();
+    if (texture) {
+        SDL_SetTextureBlendMode(texture, m_blendMode);
+    } else {
+        SDL_SetRenderDrawBlendMode(sdlRenderer, m_blendMode);
+    }
+    SDL_RenderGeometry(sdlRenderer, texture, m_vertices.data(), count * 4, m_indices.data(), count * 6);
+}
+
+int ParticleSystem::addEmitter(const ParticleEmitterConfig& config) {
+    Emitter emitter;
+    emitter.config = config;
+    emitter.accumulator = 0.0f;
+    emitter.enabled = true;
+    m_emitters.push_back(emitter);
+    return static_cast<int>(m_emitters.size()) - 1;
+}
+
+ParticleEmitterConfig& ParticleSystem::getEmitter(int index) {
+    return m_emitters[index].config;
+}
+
+int ParticleSystem::getEmitterCount() const {
+    return static_cast<int>(m_emitters.size());
+}
+
+void ParticleSystem::setEmitterEnabled(int index, bool enabled) {
+    if (index >= 0 && index < static_cast<int>(m_emitters.size())) {
+        m_emitters[index].enabled = enabled;
+        m_emitters[index].accumulator = 0.0f;
+    }
+}
+
+int ParticleSystem::emit(int index, int count) {
+    if (index < 0 || index >= static_cast<int>(m_emitters.size())) {
+        return 0;
+    }
+    return spawn(index, count);
+}
+
+void ParticleSystem::clear() {
+    m_particles.count = 0;
+}
+
+void ParticleSystem::setMaxParticles(int maxParticles) {
+    m_maxParticles = std::max(0, maxParticles);
+    m_particles.resize(m_maxParticles);
+    m_vertices.reserve(m_maxParticles * 4);
+
+    // 索引只与容量有关，每个粒子两个三角形
+    m_indices.resize(m_maxParticles * 6);
+    for (int i = 0; i < m_maxParticles; ++i) {
+        const int base = i * 4;
+        int* quad = &m_indices[i * 6];
+        quad[0] = base;
+        quad[1] = base + 1;
+        quad[2] = base + 2;
+        quad[3] = base;
+        quad[4] = base + 2;
+        quad[5] = base + 3;
+    }
+}
+
+int ParticleSystem::getMaxParticles() const {
+    return m_maxParticles;
+}
+
+int ParticleSystem::getParticleCount() const {
+    return m_particles.count;
+}
+
+void ParticleSystem::setGravityScale(float scale) {
+    m_gravityScale = scale;
+}
+
+float ParticleSystem::getGravityScale() const {
+    return m_gravityScale;
+}
+
+void ParticleSystem::setDrag(float drag) {
+    m_drag = std::max(0.0f, drag);
+}
+
+float ParticleSystem::getDrag() const {
+    return m_drag;
+}
+
+void ParticleSystem::setCollisionEnabled(bool enabled) {
+    m_collisionEnabled = enabled;
+}
+
+bool ParticleSystem::isCollisionEnabled() const {
+    return m_collisionEnabled;
+}
+
+void ParticleSystem::setCollisionLayerMask(uint32_t mask) {
+    m_collisionLayerMask = mask;
+}
+
+uint32_t ParticleSystem::getCollisionLayerMask() const {
+    return m_collisionLayerMask;
+}
+
+void ParticleSystem::setRestitution(float restitution) {
+    m_restitution = std::max(0.0f, restitution);
+}
+
+float ParticleSystem::getRestitution() const {
+    return m_restitution;
+}
+
+void ParticleSystem::setSprite(Sprite* sprite) {
+    m_sprite = sprite;
+}
+
+Sprite* ParticleSystem::getSprite() const {
+    return m_sprite;
+}
+
+void ParticleSystem::setBlendMode(SDL_BlendMode blendMode) {
+    m_blendMode = blendMode;
+}
+
+SDL_BlendMode ParticleSystem::getBlendMode() const {
+    return m_blendMode;
+}
+
+void ParticleSystem::Particles::resize(int capacity) {
+    positionsX.resize(capacity);
+    positionsY.resize(capacity);
+    velocitiesX.resize(capacity);
+    velocitiesY.resize(capacity);
+    ages.resize(capacity);
+    lifetimes.resize(capacity);
+    emitters.resize(capacity);
+    count = std::min(count, capacity);
+}
+
+void ParticleSystem::integrate(float deltaTime, const Vector2& gravity) {
+    // 各属性独立成数组，循环体只有乘加，没有分支和函数调用
+    const int count = m_particles.count;
+    float* positionsX = m_particles.positionsX.data();
+    float* positionsY = m_particles.positionsY.data();
+    float* velocitiesX = m_particles.velocitiesX.data();
+    float* velocitiesY = m_particles.velocitiesY.data();
+    float* ages = m_particles.ages.data();
+
+    const float gravityX = gravity.x * m_gravityScale * deltaTime;
+    const float gravityY = gravity.y * m_gravityScale * deltaTime;
+    const float damping = 1.0f / (1.0f + deltaTime * m_drag);
+    for (int i = 0; i < count; ++i) {
+        velocitiesX[i] = (velocitiesX[i] + gravityX) * damping;
+        velocitiesY[i] = (velocitiesY[i] + gravityY) * damping;
+        positionsX[i] += velocitiesX[i] * deltaTime;
+        positionsY[i] += velocitiesY[i] * deltaTime;
+        ages[i] += deltaTime;
+    }
+}
+
+void ParticleSystem::collideStatic(float deltaTime) {
+    const int count = m_particles.count;
+    if (count == 0) {
+        return;
+    }
+
+    float* positionsX = m_particles.positionsX.data();
+    float* positionsY = m_particles.positionsY.data();
+    float* velocitiesX = m_particles.velocitiesX.data();
+    float* velocitiesY = m_particles.velocitiesY.data();
+
+    // 本帧所有位移线段的包围盒，用一次查询取出可能碰到的静态碰撞体
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = -std::numeric_limits<float>::max();
+    float maxY = -std::numeric_limits<float>::max();
+    for (int i = 0; i < count; ++i) {
+        const float startX = positionsX[i] - velocitiesX[i] * deltaTime;
+        const float startY = positionsY[i] - velocitiesY[i] * deltaTime;
+        minX = std::min(minX, std::min(startX, positionsX[i]));
+        minY = std::min(minY, std::min(startY, positionsY[i]));
+        maxX = std::max(maxX, std::max(startX, positionsX[i]));
+        maxY = std::max(maxY, std::max(startY, positionsY[i]));
+    }
+
+    PhysicsWorld* world = Engine::getInstance().getPhysicsWorld();
+    world->queryStaticAABB(AABB(Vector2(minX, minY), Vector2(maxX, maxY)), m_staticColliders, m_collisionLayerMask);
+
+    m_staticShapes.clear();
+    m_staticBounds.clear();
+    for (auto collider : m_staticColliders) {
+        if (collider->isTrigger()) {
+            continue;
+        }
+        m_staticShapes.emplace_back();
+        buildColliderShape(collider, m_staticShapes.back());
+        m_staticBounds.push_back(computeShapeAABB(m_staticShapes.back()));
+    }
+    if (m_staticShapes.empty()) {
+        return;
+    }
+
+    // 形状较多时按覆盖的网格单元分桶（CSR布局），每个粒子只测试位移线段所在单元中的形状，
+    // 粒子分散时代价随局部形状数增长，而不是粒子数乘以全部形状数
+    const int shapeCount = static_cast<int>(m_staticShapes.size());
+    const bool useGrid = shapeCount >= MIN_SHAPES_FOR_GRID;
+    const int columns = std::max(1, std::min(static_cast<int>(std::ceil((maxX - minX) / STATIC_GRID_CELL_SIZE)),
+                                             MAX_STATIC_GRID_SIZE));
+    const int rows = std::max(1, std::min(static_cast<int>(std::ceil((maxY - minY) / STATIC_GRID_CELL_SIZE)),
+                                          MAX_STATIC_GRID_SIZE));
+    const float inverseCellWidth = maxX > minX ? columns / (maxX - minX) : 0.0f;
+    const float inverseCellHeight = maxY > minY ? rows / (maxY - minY) : 0.0f;
+    if (useGrid) {
+        m_staticCellRanges.resize(shapeCount * 4);
+        m_cellStarts.assign(columns * rows + 1, 0);
+        for (int k = 0; k < shapeCount; ++k) {
+            int* range = &m_staticCellRanges[k * 4];
+            range[0] = gridCell(m_staticBounds[k].min.x, minX, inverseCellWidth, columns);
+            range[1] = gridCell(m_staticBounds[k].min.y, minY, inverseCellHeight, rows);
+            range[2] = gridCell(m_staticBounds[k].max.x, minX, inverseCellWidth, columns);
+            range[3] = gridCell(m_staticBounds[k].max.y, minY, inverseCellHeight, rows);
+            for (int y = range[1]; y <= range[3]; ++y) {
+                for (int x = range[0]; x <= range[2]; ++x) {
+                    ++m_cellStarts[y * columns + x];
+                }
+            }
+        }
+
+        // 前缀和得到每个单元的结束位置，倒序填入后即为起始位置
+        for (int c = 1; c < columns * rows; ++c) {
+            m_cellStarts[c] += m_cellStarts[c - 1];
+        }
+        m_cellStarts[columns * rows] = m_cellStarts[columns * rows - 1];
+        m_cellShapes.resize(m_cellStarts[columns * rows]);
+        for (int k = 0; k < shapeCount; ++k) {
+            const int* range = &m_staticCellRanges[k * 4];
+            for (int y = range[1]; y <= range[3]; ++y) {
+                for (int x = range[0]; x <= range[2]; ++x) {
+                    m_cellShapes[--m_cellStarts[y * columns + x]] = k;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        const Vector2 motion(velocitiesX[i] * deltaTime, velocitiesY[i] * deltaTime);
+        const float length = motion.magnitude();
+        if (length <= 0.0f) {
+            continue;
+        }
+
+        const Vector2 end(positionsX[i], positionsY[i]);
+        const Vector2 start = end - motion;
+        const Vector2 direction = motion / length;
+        const AABB segment(Vector2(std::min(start.x, end.x), std::min(start.y, end.y)),
+                           Vector2(std::max(start.x, end.x), std::max(start.y, end.y)));
+
+        // 取最早的撞击；起点已在内部（法线为零）时不处理
+        float closest = length;
+        Vector2 hitNormal;
+        bool hit = false;
+        auto testShape = [&](int k) {
+            float distance;
+            Vector2 normal;
+            if (segment.overlaps(m_staticBounds[k]) &&
+                raycastShape(m_staticShapes[k], start, direction, closest, distance, normal) &&
+                (normal.x != 0.0f || normal.y != 0.0f)) {
+                closest = distance;
+                hitNormal = normal;
+                hit = true;
+            }
+        };
+
+        if (!useGrid) {
+            for (int k = 0; k < shapeCount; ++k) {
+                testShape(k);
+            }
+        } else {
+            const int segmentMinX = gridCell(segment.min.x, minX, inverseCellWidth, columns);
+            const int segmentMinY = gridCell(segment.min.y, minY, inverseCellHeight, rows);
+            const int segmentMaxX = gridCell(segment.max.x, minX, inverseCellWidth, columns);
+            const int segmentMaxY = gridCell(segment.max.y, minY, inverseCellHeight, rows);
+            for (int y = segmentMinY; y <= segmentMaxY; ++y) {
+                for (int x = segmentMinX; x <= segmentMaxX; ++x) {
+                    const int cell = y * columns + x;
+                    for (int entry = m_cellStarts[cell]; entry < m_cellStarts[cell + 1]; ++entry) {
+                        // 形状可能同时出现在线段覆盖的多个单元中，只在重叠区域的左上角单元测试一次
+                        const int k = m_cellShapes[entry];
+                        const int* range = &m_staticCellRanges[k * 4];
+                        if (std::max(range[0], segmentMinX) == x && std::max(range[1], segmentMinY) == y) {
+                            testShape(k);
+                        }
+                    }
+                }
+            }
+        }
+        if (!hit) {
+            continue;
+        }
+
+        // 停在撞击点并沿法线反弹
+        const Vector2 position = start + direction * closest + hitNormal * COLLISION_SKIN;
+        Vector2 velocity(velocitiesX[i], velocitiesY[i]);
+        const float normalSpeed = velocity.dot(hitNormal);
+        if (normalSpeed < 0.0f) {
+            velocity = velocity - hitNormal * ((1.0f + m_restitution) * normalSpeed);
+        }
+        positionsX[i] = position.x;
+        positionsY[i] = position.y;
+        velocitiesX[i] = velocity.x;
+        velocitiesY[i] = velocity.y;
+    }
+}
+
+void ParticleSystem::removeExpired() {
+    // 保持顺序压缩，存活的粒子前移
+    int alive = 0;
+    for (int i = 0; i < m_particles.count; ++i) {
+        if (m_particles.ages[i] >= m_particles.lifetimes[i]) {
+            continue;
+        }
+        if (alive != i) {
+            m_particles.positionsX[alive] = m_particles.positionsX[i];
+            m_particles.positionsY[alive] = m_particles.positionsY[i];
+            m_particles.velocitiesX[alive] = m_particles.velocitiesX[i];
+            m_particles.velocitiesY[alive] = m_particles.velocitiesY[i];
+            m_particles.ages[alive] = m_particles.ages[i];
+            m_particles.lifetimes[alive] = m_particles.lifetimes[i];
+            m_particles.emitters[alive] = m_particles.emitters[i];
+        }
+        ++alive;
+    }
+    m_particles.count = alive;
+}
+
+int ParticleSystem::spawn(int emitterIndex, int count) {
+    count = std::min(count, m_maxParticles - m_particles.count);
+    if (count <= 0) {
+        return 0;
+    }
+
+    // 发射点和方向随游戏对象旋转
+    const ParticleEmitterConfig& config = m_emitters[emitterIndex].config;
+    const Transform* transform = getTransform();
+    const Vector2 position = transform ? transform->getPosition() : Vector2();
+    const float rotation = transform ? transform->getRotation() : 0.0f;
+    const float cosine = std::cos(rotation);
+    const float sine = std::sin(rotation);
+    const Vector2 origin = position + Vector2(config.offset.x * cosine - config.offset.y * sine,
+                                              config.offset.x * sine + config.offset.y * cosine);
+
+    for (int k = 0; k < count; ++k) {
+        const int i = m_particles.count++;
+        const float angle = rotation + config.direction + randomRange(-0.5f, 0.5f) * config.spread;
+        const float speed = randomRange(config.minSpeed, config.maxSpeed);
+        m_particles.positionsX[i] = origin.x;
+        m_particles.positionsY[i] = origin.y;
+        m_particles.velocitiesX[i] = std::cos(angle) * speed;
+        m_particles.velocitiesY[i] = std::sin(angle) * speed;
+        m_particles.ages[i] = 0.0f;
+        m_particles.lifetimes[i] = std::max(randomRange(config.minLifetime, config.maxLifetime), MIN_LIFETIME);
+        m_particles.emitters[i] = static_cast<uint16_t>(emitterIndex);
+    }
+    return count;
+}
+
+float ParticleSystem::randomRange(float min, float max) {
+    return min + (max - min) * std::uniform_real_distribution<float>(0.0f, 1.0f)(m_random);
+}
+
+} // namespace Engine2D
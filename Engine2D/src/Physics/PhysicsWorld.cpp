@@ -0,0 +1,2375 @@
+#include "Engine2D/Physics/PhysicsWorld.h"
+#include "Engine2D/Physics/Collider.h"
+#include "Engine2D/Physics/Rigidbody.h"
+#include "Engine2D/Physics/Narrowphase.h"
+#include "Engine2D/Physics/SpatialHash.h"
+#include "Engine2D/Physics/DynamicTree.h"
+#include "Engine2D/Physics/SweepAndPrune.h"
+#include "Engine2D/Core/GameObject.h"
+#include "Engine2D/Utils/Logger.h"
+#include "Engine2D/Utils/Profiler.h"
+#include "Engine2D/Utils/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENGINE2D_PHYSICS_SSE 1
+#endif
+
+namespace Engine2D {
+
+namespace {
+    const float POSITION_CORRECTION_PERCENT = 0.4f;   // 位置修正比例
+    const float POSITION_CORRECTION_SLOP = 0.01f;     // 允许的穿透量
+    const int NARROWPHASE_BATCH_SIZE = 64;            // 并行窄相每批处理的碰撞对数量
+    const int CAST_GROUP_SIZE = 32;                   // 批量投射中共用一次宽相查询的射线数量
+    const float RESTITUTION_THRESHOLD = 1.0f;         // 低于该接近速度的接触不反弹，避免静止堆叠抖动
+    const float MAX_CONDITION_NUMBER = 1000.0f;       // 两点块求解允许的最大条件数
+    const int MAX_CCD_SUBSTEPS = 4;                   // 连续碰撞检测每步最多的子步数
+    const float CCD_SLOP = 0.05f;                     // 撞击时刻停在表面之前的距离，避免下一子步从内部出发
+
+    // 获取碰撞体的包围盒，有向矩形按旋转后的顶点计算
+    AABB computeAABB(const Collider* collider) {
+        if (isOrientedBox(collider)) {
+            ColliderShape shape;
+            buildColliderShape(collider, shape);
+            return computeShapeAABB(shape);
+        }
+
+        AABB aabb;
+        collider->getBoundingBox(aabb.min, aabb.max);
+        return aabb;
+    }
+
+    // 获取碰撞体对应刚体的质量倒数，静态、运动学或没有刚体时为0
+    float getInverseMass(const Rigidbody* body) {
+        if (!body || body->getBodyType() != BodyType::DYNAMIC || body->getMass() <= 0.0f) {
+            return 0.0f;
+        }
+        return 1.0f / body->getMass();
+    }
+
+    // 获取刚体的转动惯量倒数，非动态或固定旋转时为0
+    float getInverseInertia(const Rigidbody* body) {
+        if (!body || body->getBodyType() != BodyType::DYNAMIC || body->isFixedRotation()) {
+            return 0.0f;
+        }
+        return body->getInverseInertia();
+    }
+
+    // 标量角速度与向量的叉积 w x r
+    Vector2 crossScalar(float w, const Vector2& r) {
+        return Vector2(-w * r.y, w * r.x);
+    }
+
+    // 无刚体或静态刚体的碰撞体属于静态分区，瓦片地图总是静态的
+    bool isStaticCollider(const Collider* collider) {
+        const Rigidbody* body = collider->getRigidbody();
+        return !body || body->getBodyType() == BodyType::STATIC || collider->getType() == ColliderType::TILEMAP;
+    }
+
+    using StepClock = std::chrono::steady_clock;
+
+    // Profiler中各阶段的名称，预先构造避免每步分配字符串
+    const std::string PROFILE_INTEGRATE_FORCES = "Physics::integrateForces";
+    const std::string PROFILE_DETECT_COLLISIONS = "Physics::detectCollisions";
+    const std::string PROFILE_RESOLVE_COLLISIONS = "Physics::resolveCollisions";
+    const std::string PROFILE_INTEGRATE_VELOCITIES = "Physics::integrateVelocities";
+
+    // 从start到现在经过的毫秒数
+    float elapsedMilliseconds(StepClock::time_point start) {
+        return std::chrono::duration<float, std::milli>(StepClock::now() - start).count();
+    }
+
+    // 碰撞层在层碰撞矩阵中的下标，超出范围的层按第0层处理
+    int layerIndex(int layer) {
+        return layer >= 0 && layer < PhysicsWorld::LAYER_COUNT ? layer : 0;
+    }
+
+    // 刚体是否参与模拟（非静态且未休眠）
+    bool isAwakeBody(const Rigidbody* body) {
+        return body && body->getBodyType() != BodyType::STATIC && !body->isAsleep();
+    }
+
+    // 规范化后的碰撞对哈希，两个指针经乘法混合后取高位
+    size_t hashPair(const Collider* a, const Collider* b) {
+        const uint64_t keyA = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(a));
+        const uint64_t keyB = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(b));
+        const uint64_t hash = (keyA * 0x9E3779B97F4A7C15ull) ^ (keyB * 0xC2B2AE3D27D4EB4Full);
+        return static_cast<size_t>(hash ^ (hash >> 29));
+    }
+
+    // 接触流形按碰撞体对和子形状排序比较，用于查找热启动缓存
+    bool manifoldLess(const ContactManifold& a, const ContactManifold& b) {
+        if (a.pairKey != b.pairKey) {
+            return a.pairKey < b.pairKey;
+        }
+        return a.subShape < b.subShape;
+    }
+
+    // 两个登记序号组成的排序键，较小的序号在高位
+    uint64_t makePairKey(uint32_t idA, uint32_t idB) {
+        return (static_cast<uint64_t>(idA) << 32) | idB;
+    }
+
+    // 射线与包围盒求交（slab方法）
+    bool rayIntersectsAABB(const Vector2& origin, const Vector2& direction, const AABB& aabb,
+                           float maxDistance, float& distance, Vector2& normal) {
+        float tMin = 0.0f;
+        float tMax = maxDistance;
+        Vector2 hitNormal;
+
+        const float origins[2] = { origin.x, origin.y };
+        const float directions[2] = { direction.x, direction.y };
+        const float mins[2] = { aabb.min.x, aabb.min.y };
+        const float maxs[2] = { aabb.max.x, aabb.max.y };
+
+        for (int axis = 0; axis < 2; ++axis) {
+            if (std::fabs(directions[axis]) < 1e-8f) {
+                if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) {
+                    return false;
+                }
+                continue;
+            }
+
+            const float inverse = 1.0f / directions[axis];
+            float t1 = (mins[axis] - origins[axis]) * inverse;
+            float t2 = (maxs[axis] - origins[axis]) * inverse;
+            float sign = -1.0f;
+            if (t1 > t2) {
+                std::swap(t1, t2);
+                sign = 1.0f;
+            }
+            if (t1 > tMin) {
+                tMin = t1;
+                hitNormal = axis == 0 ? Vector2(sign, 0.0f) : Vector2(0.0f, sign);
+            }
+            tMax = std::min(tMax, t2);
+            if (tMin > tMax) {
+                return false;
+            }
+        }
+
+        distance = tMin;
+        normal = hitNormal;
+        return true;
+    }
+
+    // 射线与结构数组排列的一组包围盒做slab测试，层位匹配且相交的下标写入candidates。
+    // 数量需按4对齐，补齐的包围盒层位为0，不会通过测试
+    void rayVsBounds(const float* minX, const float* minY, const float* maxX, const float* maxY,
+                     const uint32_t* layers, int count, const Vector2& origin, const Vector2& inverseDirection,
+                     float maxDistance, uint32_t layerMask, std::vector<int>& candidates) {
+#ifdef ENGINE2D_PHYSICS_SSE
+        const __m128 originX = _mm_set1_ps(origin.x);
+        const __m128 originY = _mm_set1_ps(origin.y);
+        const __m128 inverseX = _mm_set1_ps(inverseDirection.x);
+        const __m128 inverseY = _mm_set1_ps(inverseDirection.y);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 limit = _mm_set1_ps(maxDistance);
+        for (int i = 0; i < count; i += 4) {
+            const __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(minX + i), originX), inverseX);
+            const __m128 x2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxX + i), originX), inverseX);
+            const __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(minY + i), originY), inverseY);
+            const __m128 y2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxY + i), originY), inverseY);
+            const __m128 tMin = _mm_max_ps(_mm_max_ps(_mm_min_ps(x1, x2), _mm_min_ps(y1, y2)), zero);
+            const __m128 tMax = _mm_min_ps(_mm_min_ps(_mm_max_ps(x1, x2), _mm_max_ps(y1, y2)), limit);
+            int mask = _mm_movemask_ps(_mm_cmple_ps(tMin, tMax));
+            while (mask) {
+                const int lane = mask & 1 ? 0 : mask & 2 ? 1 : mask & 4 ? 2 : 3;
+                mask &= mask - 1;
+                if (layers[i + lane] & layerMask) {
+                    candidates.push_back(i + lane);
+                }
+            }
+        }
+#else
+        for (int i = 0; i < count; ++i) {
+            const float x1 = (minX[i] - origin.x) * inverseDirection.x;
+            const float x2 = (maxX[i] - origin.x) * inverseDirection.x;
+            const float y1 = (minY[i] - origin.y) * inverseDirection.y;
+            const float y2 = (maxY[i] - origin.y) * inverseDirection.y;
+            const float tMin = std::max(std::max(std::min(x1, x2), std::min(y1, y2)), 0.0f);
+            const float tMax = std::min(std::min(std::max(x1, x2), std::max(y1, y2)), maxDistance);
+            if (tMin <= tMax && (layers[i] & layerMask)) {
+                candidates.push_back(i);
+            }
+        }
+#endif
+    }
+
+    // 把点量化为包围盒内的16位坐标并交错两轴的位，得到它在Z序曲线上的位置
+    uint32_t mortonCode(const Vector2& point, const AABB& bounds) {
+        auto quantize = [](float value, float minimum, float maximum) {
+            const float extent = maximum - minimum;
+            const float t = extent > 0.0f ? (value - minimum) / extent : 0.0f;
+            return static_cast<uint32_t>(std::min(std::max(t, 0.0f), 1.0f) * 65535.0f);
+        };
+        auto spread = [](uint32_t value) {
+            value = (value | (value << 8)) & 0x00FF00FFu;
+            value = (value | (value << 4)) & 0x0F0F0F0Fu;
+            value = (value | (value << 2)) & 0x33333333u;
+            value = (value | (value << 1)) & 0x55555555u;
+            return value;
+        };
+        return spread(quantize(point.x, bounds.min.x, bounds.max.x)) |
+               (spread(quantize(point.y, bounds.min.y, bounds.max.y)) << 1);
+    }
+
+    // 方向分量的倒数，分量为0时用极小值代替，使slab测试不产生NaN
+    float safeInverse(float value) {
+        const float minimum = 1e-12f;
+        return 1.0f / (std::fabs(value) > minimum ? value : (value < 0.0f ? -minimum : minimum));
+    }
+
+    // 由窄相接触点填充对外的碰撞信息：取两点中点与最大穿透
+    void fillCollisionInfo(Collider* colliderA, Collider* colliderB, const ContactPoints& contact, CollisionInfo& info) {
+        info.colliderA = colliderA;
+        info.colliderB = colliderB;
+        info.normal = contact.normal;
+        info.contactPoint = contact.points[0];
+        info.penetration = contact.penetrations[0];
+        if (contact.pointCount == 2) {
+            info.contactPoint = (contact.points[0] + contact.points[1]) * 0.5f;
+            info.penetration = std::max(contact.penetrations[0], contact.penetrations[1]);
+        }
+    }
+
+    // 以下为窄相函数表的各项，只读取形状数据
+    bool collideBoxBox(const ColliderShape& a, const ColliderShape& b, ContactPoints& contact) {
+        if (a.box.rotation == 0.0f && b.box.rotation == 0.0f) {
+            return collideAlignedBoxes(a.box, b.box, contact);
+        }
+        PolygonShape polygonA;
+        PolygonShape polygonB;
+        makeBoxShape(a.box, polygonA);
+        makeBoxShape(b.box, polygonB);
+        return collidePolygons(polygonA, polygonB, contact);
+    }
+
+    bool collideBoxCircle(const ColliderShape& a, const ColliderShape& b, ContactPoints& contact) {
+        PolygonShape polygon;
+        makeBoxShape(a.box, polygon);
+        return collidePolygonCircle(polygon, b.circle, contact);
+    }
+
+    bool collideBoxPolygon(const ColliderShape& a, const ColliderShape& b, ContactPoints& contact) {
+        PolygonShape polygon;
+        makeBoxShape(a.box, polygon);
+        return collidePolygons(polygon, *b.polygon, contact);
+    }
+
+    bool collideCircleCircle(const ColliderShape& a, const ColliderShape& b, ContactPoints& contact) {
+        return collideCircles(a.circle, b.circle, contact);
+    }
+
+    bool collidePolygonAndCircle(const ColliderShape& a, const ColliderShape& b, ContactPoints& contact) {
+        return collidePolygonCircle(*a.polygon, b.circle, contact);
+    }
+
+    bool collidePolygonPolygon(const ColliderShape& a, const ColliderShape& b, ContactPoints& contact) {
+        return collidePolygons(*a.polygon, *b.polygon, contact);
+    }
+
+    // 交换两侧复用已有的检测函数，法线方向随之取反
+    template <NarrowphaseFunction Function>
+    bool collideSwapped(const ColliderShape& a, const ColliderShape& b, ContactPoints& contact) {
+        if (!Function(b, a, contact)) {
+            return false;
+        }
+        contact.normal = contact.normal * -1.0f;
+        return true;
+    }
+}
+
+// 按 [ColliderType A][ColliderType B] 索引，顺序与 BOX、CIRCLE、POLYGON 一致
+const NarrowphaseFunction PhysicsWorld::s_narrowphaseTable[SHAPE_TYPE_COUNT][SHAPE_TYPE_COUNT] = {
+    { collideBoxBox, collideBoxCircle, collideBoxPolygon },
+    { collideSwapped<collideBoxCircle>, collideCircleCircle, collideSwapped<collidePolygonAndCircle> },
+    { collideSwapped<collideBoxPolygon>, collidePolygonAndCircle, collidePolygonPolygon }
+};
+
+PhysicsWorld::PhysicsWorld()
+    : m_gravity(0.0f, 9.8f)
+    , m_enabled(true)
+    , m_iterations(6)
+    , m_staticLayers(0)
+    , m_layerMatrixFull(true)
+    , m_profilingEnabled(true)
+    , m_broadphaseCellSize(64.0f)
+    , m_broadphaseMargin(4.0f)
+    , m_nextColliderId(0)
+    , m_sleepingEnabled(true)
+    , m_linearSleepThreshold(2.0f)
+    , m_angularSleepThreshold(0.035f)
+    , m_timeToSleep(0.5f) {
+    m_broadphase = createBroadphase(BroadphaseType::SPATIAL_HASH);
+    std::fill(m_layerMatrix, m_layerMatrix + LAYER_COUNT, 0xFFFFFFFFu);
+}
+
+PhysicsWorld::~PhysicsWorld() {
+    shutdown();
+}
+
+void PhysicsWorld::initialize() {
+    m_enabled = true;
+    LOG_DEBUG("物理世界初始化");
+}
+
+void PhysicsWorld::update(float deltaTime, int iterations) {
+    if (!m_enabled || deltaTime <= 0.0f) {
+        return;
+    }
+
+    m_iterations = std::max(1, iterations);
+    m_stats = PhysicsStats();
+    m_stats.bodyCount = static_cast<int>(m_rigidbodies.size());
+    Profiler* profiler = m_profilingEnabled ? &Profiler::getInstance() : nullptr;
+    const StepClock::time_point stepStart = StepClock::now();
+
+    // 依次执行各阶段，分别计时并记录到Profiler
+    auto runPhase = [profiler](const std::string& name, float& time, const auto& phase) {
+        if (profiler) {
+            profiler->begin(name);
+        }
+        const StepClock::time_point start = StepClock::now();
+        phase();
+        time = elapsedMilliseconds(start);
+        if (profiler) {
+            profiler->end(name);
+        }
+    };
+
+    runPhase(PROFILE_INTEGRATE_FORCES, m_stats.integrateForcesTime, [&]() {
+        integrateForces(deltaTime);
+    });
+    runPhase(PROFILE_DETECT_COLLISIONS, m_stats.detectCollisionsTime, [&]() {
+        detectCollisions();
+        buildIslands();
+    });
+    runPhase(PROFILE_RESOLVE_COLLISIONS, m_stats.resolveCollisionsTime, [&]() {
+        resolveCollisions();
+    });
+    runPhase(PROFILE_INTEGRATE_VELOCITIES, m_stats.integrateVelocitiesTime, [&]() {
+        integrateVelocities(deltaTime);
+    });
+    writeBackTransforms();
+    updateSleep(deltaTime);
+
+    m_stats.contactCount = static_cast<int>(m_contacts.size());
+    m_stats.islandCount = static_cast<int>(m_solverIslands.size());
+    m_stats.solverIterations = m_solverIslands.empty() ? 0 : m_iterations;
+    m_stats.stepTime = elapsedMilliseconds(stepStart);
+
+    // 回调放在整步完成之后，回调中添加或移除刚体不会打乱本步仍在使用的下标
+    dispatchEvents();
+}
+
+void PhysicsWorld::shutdown() {
+    // 将运动状态复制回刚体后解除句柄
+    for (int i = 0; i < static_cast<int>(m_rigidbodies.size()); ++i) {
+        Rigidbody* body = m_rigidbodies[i];
+        body->m_velocity = m_bodies.velocities[i];
+        body->m_angularVelocity = m_bodies.angularVelocities[i];
+        body->m_force = m_bodies.forces[i];
+        body->m_torque = m_bodies.torques[i];
+        body->m_world = nullptr;
+        body->m_bodyIndex = -1;
+    }
+    m_rigidbodies.clear();
+    m_bodies.clear();
+    m_transformBodies.clear();
+    m_colliders.clear();
+    m_broadphase->clear();
+    for (auto& bucket : m_staticBuckets) {
+        bucket.reset();
+    }
+    m_staticLayers = 0;
+    m_dynamicColliders.clear();
+    m_proxyIds.clear();
+    m_nextColliderId = 0;
+    m_transformColliders.clear();
+    m_pairBuffer.clear();
+    m_contacts.clear();
+    m_previousPairs.clear();
+    m_currentPairs.clear();
+    m_contactEvents.clear();
+    m_manifolds.clear();
+    m_manifoldCache.clear();
+    m_sleepTimers.clear();
+    m_sleepLinks.clear();
+}
+
+void PhysicsWorld::addRigidbody(Rigidbody* rigidbody) {
+    if (!rigidbody || rigidbody->m_world) {
+        return;
+    }
+
+    const int index = static_cast<int>(m_rigidbodies.size());
+    m_rigidbodies.push_back(rigidbody);
+    m_sleepTimers.push_back(0.0f);
+    m_sleepLinks.push_back(-1);
+
+    // 运动状态迁移到状态数组，刚体此后只作为句柄
+    Transform* transform = rigidbody->getTransform();
+    m_bodies.push();
+    m_bodies.transforms[index] = transform;
+    m_bodies.positions[index] = transform ? transform->getPosition() : Vector2();
+    m_bodies.rotations[index] = transform ? transform->getRotation() : 0.0f;
+    m_bodies.velocities[index] = rigidbody->m_velocity;
+    m_bodies.angularVelocities[index] = rigidbody->m_angularVelocity;
+    m_bodies.forces[index] = rigidbody->m_force;
+    m_bodies.torques[index] = rigidbody->m_torque;
+    rigidbody->m_world = this;
+    rigidbody->m_bodyIndex = index;
+    if (transform) {
+        m_transformBodies[transform] = index;
+    }
+    refreshBody(rigidbody);
+
+    // 先添加碰撞体后添加刚体时，碰撞体需要迁移到动态分区
+    auto it = m_transformColliders.find(transform);
+    if (it != m_transformColliders.end()) {
+        for (auto collider : it->second) {
+            updateCollider(collider);
+        }
+    }
+}
+
+bool PhysicsWorld::removeRigidbody(Rigidbody* rigidbody) {
+    const int index = getBodyIndex(rigidbody);
+    if (index < 0) {
+        return false;
+    }
+
+    // 运动状态复制回刚体
+    rigidbody->m_velocity = m_bodies.velocities[index];
+    rigidbody->m_angularVelocity = m_bodies.angularVelocities[index];
+    rigidbody->m_force = m_bodies.forces[index];
+    rigidbody->m_torque = m_bodies.torques[index];
+    rigidbody->m_world = nullptr;
+    rigidbody->m_bodyIndex = -1;
+    m_transformBodies.erase(m_bodies.transforms[index]);
+
+    // 从所在休眠岛的环形链表中摘除，岛内其余刚体保持休眠
+    if (m_sleepLinks[index] >= 0) {
+        int previous = index;
+        while (m_sleepLinks[previous] != index) {
+            previous = m_sleepLinks[previous];
+        }
+        m_sleepLinks[previous] = m_sleepLinks[index];
+        m_sleepLinks[index] = -1;
+    }
+
+    // 与末尾交换删除，只需修正被移动刚体的下标
+    const int last = static_cast<int>(m_rigidbodies.size()) - 1;
+    m_rigidbodies[index] = m_rigidbodies[last];
+    m_sleepTimers[index] = m_sleepTimers[last];
+    m_sleepLinks[index] = m_sleepLinks[last];
+    m_bodies.swapRemove(index);
+    m_rigidbodies.pop_back();
+    m_sleepTimers.pop_back();
+    m_sleepLinks.pop_back();
+    if (index != last) {
+        m_rigidbodies[index]->m_bodyIndex = index;
+        if (m_bodies.transforms[index]) {
+            m_transformBodies[m_bodies.transforms[index]] = index;
+        }
+
+        // 链表中指向被移动刚体的前驱改为指向新下标
+        if (m_sleepLinks[index] >= 0) {
+            int previous = index;
+            while (m_sleepLinks[previous] != last) {
+                previous = m_sleepLinks[previous];
+            }
+            m_sleepLinks[previous] = index;
+        }
+    }
+    return true;
+}
+
+void PhysicsWorld::addCollider(Collider* collider) {
+    if (!collider || m_proxyIds.find(collider) != m_proxyIds.end()) {
+        return;
+    }
+
+    m_colliders.push_back(collider);
+    insertProxy(collider, m_nextColliderId++);
+
+    if (Transform* transform = collider->getTransform()) {
+        m_transformColliders[transform].push_back(collider);
+
+        // 转动惯量取决于碰撞体形状，刚体通常先于碰撞体添加
+        auto bodyIt = m_transformBodies.find(transform);
+        if (bodyIt != m_transformBodies.end()) {
+            m_rigidbodies[bodyIt->second]->recalculateMassData();
+        }
+    }
+}
+
+bool PhysicsWorld::removeCollider(Collider* collider) {
+    auto proxyIt = m_proxyIds.find(collider);
+    if (proxyIt == m_proxyIds.end()) {
+        return false;
+    }
+
+    destroyProxy(collider);
+
+    auto it = std::find(m_colliders.begin(), m_colliders.end(), collider);
+    if (it != m_colliders.end()) {
+        m_colliders.erase(it);
+    }
+
+    auto mapIt = m_transformColliders.find(collider->getTransform());
+    if (mapIt != m_transformColliders.end()) {
+        auto& colliders = mapIt->second;
+        colliders.erase(std::remove(colliders.begin(), colliders.end(), collider), colliders.end());
+        if (colliders.empty()) {
+            m_transformColliders.erase(mapIt);
+        }
+    }
+
+    // 移除悬空的事件记录
+    m_previousPairs.remove(collider);
+    m_manifoldCache.erase(std::remove_if(m_manifoldCache.begin(), m_manifoldCache.end(), [collider](const ContactManifold& manifold) {
+        return manifold.colliderA == collider || manifold.colliderB == collider;
+    }), m_manifoldCache.end());
+
+    return true;
+}
+
+void PhysicsWorld::setGravity(const Vector2& gravity) {
+    m_gravity = gravity;
+}
+
+const Vector2& PhysicsWorld::getGravity() const {
+    return m_gravity;
+}
+
+void PhysicsWorld::setCollisionCallback(const CollisionCallback& callback) {
+    m_collisionCallback = callback;
+}
+
+void PhysicsWorld::setContactEventCallback(const ContactEventCallback& callback) {
+    m_contactEventCallback = callback;
+}
+
+const ContactEvents& PhysicsWorld::getContactEvents() const {
+    return m_contactEvents;
+}
+
+bool PhysicsWorld::checkCollision(Collider* colliderA, Collider* colliderB, CollisionInfo& info) {
+    if (!colliderA || !colliderB || colliderA == colliderB) {
+        return false;
+    }
+
+    ColliderShape shapeA;
+    ColliderShape shapeB;
+    buildColliderShape(colliderA, shapeA);
+    buildColliderShape(colliderB, shapeB);
+
+    ContactPoints contact;
+    if (!collideShapes(shapeA, shapeB, contact)) {
+        return false;
+    }
+    fillCollisionInfo(colliderA, colliderB, contact, info);
+    return true;
+}
+
+int PhysicsWorld::raycastBatch(const std::vector<Ray>& rays, std::vector<RaycastHit>& hits, RaycastMode mode) {
+    return castBatch(rays, 0.0f, Vector2(), false, hits, mode);
+}
+
+int PhysicsWorld::circleCastBatch(const std::vector<Ray>& rays, float radius, std::vector<RaycastHit>& hits,
+                                  RaycastMode mode) {
+    return castBatch(rays, std::max(0.0f, radius), Vector2(), false, hits, mode);
+}
+
+int PhysicsWorld::boxCastBatch(const std::vector<Ray>& rays, const Vector2& halfExtents, std::vector<RaycastHit>& hits,
+                               RaycastMode mode) {
+    return castBatch(rays, 0.0f, Vector2(std::fabs(halfExtents.x), std::fabs(halfExtents.y)), true, hits, mode);
+}
+
+bool PhysicsWorld::collideShapes(const ColliderShape& shapeA, const ColliderShape& shapeB, ContactPoints& contact) {
+    const bool tilemapA = shapeA.type == ColliderType::TILEMAP;
+    if (!tilemapA && shapeB.type != ColliderType::TILEMAP) {
+        const NarrowphaseFunction function =
+            s_narrowphaseTable[static_cast<int>(shapeA.type)][static_cast<int>(shapeB.type)];
+        return function(shapeA, shapeB, contact);
+    }
+    if (tilemapA && shapeB.type == ColliderType::TILEMAP) {
+        return false;
+    }
+
+    // 与另一侧包围盒重叠的矩形逐个检测，保留穿透最深的结果
+    const TilemapCollider& tilemap = tilemapA ? *shapeA.tilemap : *shapeB.tilemap;
+    const ColliderShape& other = tilemapA ? shapeB : shapeA;
+    float deepest = -std::numeric_limits<float>::max();
+    bool hit = false;
+    tilemap.forEachRect(computeShapeAABB(other), [&](int index) {
+        ColliderShape rect;
+        tilemap.buildRectShape(index, rect);
+        ContactPoints candidate;
+        const bool overlaps = tilemapA ? collideShapes(rect, other, candidate) : collideShapes(other, rect, candidate);
+        if (!overlaps) {
+            return;
+        }
+        const float penetration = candidate.pointCount == 2 ?
+            std::max(candidate.penetrations[0], candidate.penetrations[1]) : candidate.penetrations[0];
+        if (penetration > deepest) {
+            deepest = penetration;
+            contact = candidate;
+            hit = true;
+        }
+    });
+    return hit;
+}
+
+bool PhysicsWorld::raycast(const Vector2& origin, const Vector2& direction, float maxDistance, CollisionInfo& hitInfo) {
+    const Vector2 dir = direction.normalized();
+    if (dir.x == 0.0f && dir.y == 0.0f) {
+        return false;
+    }
+
+    float closest = maxDistance;
+    bool hit = false;
+
+    auto testCollider = [&](Collider* collider) -> float {
+        if (!collider->isActive() || collider->isTrigger()) {
+            return closest;
+        }
+
+        // 轴对齐矩形直接用包围盒求交，其余形状使用窄相的射线内核
+        float distance;
+        Vector2 normal;
+        bool intersects;
+        if (collider->getType() == ColliderType::BOX && !isOrientedBox(collider)) {
+            intersects = rayIntersectsAABB(origin, dir, computeAABB(collider), closest, distance, normal);
+        } else {
+            ColliderShape shape;
+            buildColliderShape(collider, shape);
+            intersects = raycastShape(shape, origin, dir, closest, distance, normal);
+        }
+
+        if (intersects && distance <= closest) {
+            closest = distance;
+            hit = true;
+            hitInfo.colliderA = collider;
+            hitInfo.colliderB = nullptr;
+            hitInfo.contactPoint = origin + dir * distance;
+            hitInfo.normal = normal;
+            hitInfo.penetration = distance;
+        }
+        return closest;
+    };
+
+    for (int layer = 0; layer < LAYER_COUNT; ++layer) {
+        if (m_staticLayers & (1u << layer)) {
+            m_staticBuckets[layer]->raycast(origin, dir, closest, testCollider);
+        }
+    }
+    m_broadphase->raycast(origin, dir, closest, testCollider);
+
+    return hit;
+}
+
+void PhysicsWorld::setEnabled(bool enabled) {
+    m_enabled = enabled;
+}
+
+bool PhysicsWorld::isEnabled() const {
+    return m_enabled;
+}
+
+void PhysicsWorld::setBroadphaseType(BroadphaseType type) {
+    if (m_broadphase->getType() == type) {
+        return;
+    }
+
+    // 在新后端中重建所有动态代理，静态分区不受影响
+    m_broadphase = createBroadphase(type);
+    for (auto collider : m_dynamicColliders) {
+        m_proxyIds[collider].proxyId = m_broadphase->createProxy(computeAABB(collider), collider);
+    }
+    m_pairBuffer.clear();
+}
+
+BroadphaseType PhysicsWorld::getBroadphaseType() const {
+    return m_broadphase->getType();
+}
+
+void PhysicsWorld::setBroadphaseCellSize(float cellSize) {
+    if (cellSize <= 0.0f) {
+        return;
+    }
+
+    m_broadphaseCellSize = cellSize;
+    if (m_broadphase->getType() == BroadphaseType::SPATIAL_HASH) {
+        static_cast<SpatialHash*>(m_broadphase.get())->setCellSize(cellSize);
+    }
+}
+
+float PhysicsWorld::getBroadphaseCellSize() const {
+    return m_broadphaseCellSize;
+}
+
+void PhysicsWorld::setBroadphaseMargin(float margin) {
+    m_broadphaseMargin = std::max(0.0f, margin);
+    if (m_broadphase->getType() == BroadphaseType::DYNAMIC_TREE) {
+        static_cast<DynamicTree*>(m_broadphase.get())->setMargin(m_broadphaseMargin);
+    }
+}
+
+float PhysicsWorld::getBroadphaseMargin() const {
+    return m_broadphaseMargin;
+}
+
+int PhysicsWorld::queryAABB(const AABB& area, std::vector<Collider*>& results) {
+    results.clear();
+    m_broadphase->query(area, results);
+    queryStatic(area, 0xFFFFFFFFu, results);
+
+    // 宽相可能返回胖包围盒重叠的碰撞体，这里按实际包围盒过滤
+    results.erase(std::remove_if(results.begin(), results.end(), [&area](Collider* collider) {
+        return !collider->isActive() || !computeAABB(collider).overlaps(area);
+    }), results.end());
+
+    return static_cast<int>(results.size());
+}
+
+int PhysicsWorld::queryStaticAABB(const AABB& area, std::vector<Collider*>& results, uint32_t layerMask) {
+    results.clear();
+    queryStatic(area, layerMask, results);
+
+    results.erase(std::remove_if(results.begin(), results.end(), [&area](Collider* collider) {
+        return !collider->isActive() || !computeAABB(collider).overlaps(area);
+    }), results.end());
+
+    return static_cast<int>(results.size());
+}
+
+int PhysicsWorld::overlapBox(const Vector2& center, const Vector2& halfExtents, float rotation,
+                             Collider** results, int maxResults, uint32_t layerMask) {
+    ColliderShape shape;
+    shape.type = ColliderType::BOX;
+    shape.box.center = center;
+    shape.box.halfExtents = Vector2(std::fabs(halfExtents.x), std::fabs(halfExtents.y));
+    shape.box.rotation = rotation;
+    return overlapShape(shape, false, results, maxResults, layerMask);
+}
+
+int PhysicsWorld::overlapCircle(const Vector2& center, float radius, Collider** results, int maxResults,
+                                uint32_t layerMask) {
+    ColliderShape shape;
+    shape.type = ColliderType::CIRCLE;
+    shape.circle.center = center;
+    shape.circle.radius = std::max(0.0f, radius);
+    return overlapShape(shape, false, results, maxResults, layerMask);
+}
+
+int PhysicsWorld::queryPoint(const Vector2& point, Collider** results, int maxResults, uint32_t layerMask) {
+    ColliderShape shape;
+    shape.type = ColliderType::CIRCLE;
+    shape.circle.center = point;
+    return overlapShape(shape, true, results, maxResults, layerMask);
+}
+
+void PhysicsWorld::updateCollider(Collider* collider) {
+    auto it = m_proxyIds.find(collider);
+    if (it == m_proxyIds.end()) {
+        return;
+    }
+
+    if (it->second.isStatic != isStaticCollider(collider) ||
+        (it->second.isStatic && it->second.layer != layerIndex(collider->getLayer()))) {
+        // 分区或层桶发生变化，迁移到另一个结构
+        const uint32_t id = it->second.id;
+        destroyProxy(collider);
+        insertProxy(collider, id);
+    } else if (it->second.isStatic) {
+        m_staticBuckets[it->second.layer]->moveProxy(it->second.proxyId, computeAABB(collider));
+    } else {
+        m_broadphase->moveProxy(it->second.proxyId, computeAABB(collider));
+    }
+}
+
+int PhysicsWorld::getStaticColliderCount() const {
+    int count = 0;
+    for (int layer = 0; layer < LAYER_COUNT; ++layer) {
+        if (m_staticLayers & (1u << layer)) {
+            count += m_staticBuckets[layer]->getProxyCount();
+        }
+    }
+    return count;
+}
+
+void PhysicsWorld::setLayerCollision(int layerA, int layerB, bool collide) {
+    const int a = layerIndex(layerA);
+    const int b = layerIndex(layerB);
+    if (collide) {
+        m_layerMatrix[a] |= 1u << b;
+        m_layerMatrix[b] |= 1u << a;
+    } else {
+        m_layerMatrix[a] &= ~(1u << b);
+        m_layerMatrix[b] &= ~(1u << a);
+    }
+
+    m_layerMatrixFull = std::all_of(m_layerMatrix, m_layerMatrix + LAYER_COUNT, [](uint32_t row) {
+        return row == 0xFFFFFFFFu;
+    });
+}
+
+bool PhysicsWorld::getLayerCollision(int layerA, int layerB) const {
+    return (m_layerMatrix[layerIndex(layerA)] >> layerIndex(layerB)) & 1u;
+}
+
+uint32_t PhysicsWorld::getLayerCollisionMask(int layer) const {
+    return m_layerMatrix[layerIndex(layer)];
+}
+
+void PhysicsWorld::setSleepingEnabled(bool enabled) {
+    m_sleepingEnabled = enabled;
+    if (!enabled) {
+        for (auto body : m_rigidbodies) {
+            if (body->isAsleep()) {
+                wakeIsland(body);
+            }
+        }
+    }
+}
+
+bool PhysicsWorld::isSleepingEnabled() const {
+    return m_sleepingEnabled;
+}
+
+void PhysicsWorld::setSleepThresholds(float linearThreshold, float angularThreshold) {
+    m_linearSleepThreshold = std::max(0.0f, linearThreshold);
+    m_angularSleepThreshold = std::max(0.0f, angularThreshold);
+}
+
+void PhysicsWorld::setTimeToSleep(float seconds) {
+    m_timeToSleep = std::max(0.0f, seconds);
+}
+
+float PhysicsWorld::getTimeToSleep() const {
+    return m_timeToSleep;
+}
+
+void PhysicsWorld::wakeIsland(Rigidbody* rigidbody) {
+    const int index = getBodyIndex(rigidbody);
+    if (index < 0 || m_sleepLinks[index] < 0) {
+        // 不属于任何休眠岛（例如被手动休眠），只唤醒自身
+        rigidbody->m_asleep = false;
+        if (index >= 0) {
+            m_sleepTimers[index] = 0.0f;
+        }
+        return;
+    }
+
+    // 沿环形链表唤醒岛内所有刚体
+    int current = index;
+    do {
+        const int next = m_sleepLinks[current];
+        m_sleepLinks[current] = -1;
+        m_rigidbodies[current]->m_asleep = false;
+        m_sleepTimers[current] = 0.0f;
+        current = next;
+    } while (current != index);
+}
+
+void PhysicsWorld::setThreadCount(int threadCount) {
+    threadCount = std::max(0, threadCount);
+    if (threadCount == getThreadCount()) {
+        return;
+    }
+
+    m_threadPool.reset();
+    if (threadCount > 0) {
+        m_threadPool = std::make_unique<ThreadPool>(threadCount);
+    }
+}
+
+int PhysicsWorld::getThreadCount() const {
+    return m_threadPool ? m_threadPool->getThreadCount() : 0;
+}
+
+void PhysicsWorld::syncTransforms() {
+    for (auto transform : Transform::getMovedTransforms()) {
+        // 被游戏逻辑移动的刚体以Transform为准；物理世界自己写回的位置与刚体数据相同，不算移动
+        auto bodyIt = m_transformBodies.find(transform);
+        if (bodyIt != m_transformBodies.end()) {
+            const int index = bodyIt->second;
+            const Vector2& position = transform->getPosition();
+            if (position.x != m_bodies.positions[index].x || position.y != m_bodies.positions[index].y ||
+                transform->getRotation() != m_bodies.rotations[index]) {
+                m_bodies.positions[index] = position;
+                m_bodies.rotations[index] = transform->getRotation();
+
+                // 休眠的刚体不参与积分，被传送后需要唤醒整个岛，否则会悬停在新位置
+                if (m_rigidbodies[index]->isAsleep()) {
+                    wakeIsland(m_rigidbodies[index]);
+                }
+            }
+        }
+
+        auto it = m_transformColliders.find(transform);
+        if (it == m_transformColliders.end()) {
+            continue;
+        }
+        for (auto collider : it->second) {
+            updateProxy(collider);
+        }
+    }
+}
+
+const std::vector<BroadphasePair>& PhysicsWorld::getBroadphasePairs() const {
+    return m_pairBuffer;
+}
+
+const std::vector<CollisionInfo>& PhysicsWorld::getContacts() const {
+    return m_contacts;
+}
+
+const std::vector<ContactManifold>& PhysicsWorld::getManifolds() const {
+    return m_manifolds;
+}
+
+const PhysicsStats& PhysicsWorld::getStats() const {
+    return m_stats;
+}
+
+void PhysicsWorld::saveState(PhysicsSnapshot& snapshot) {
+    syncTransforms();
+
+    snapshot.rigidbodies.assign(m_rigidbodies.begin(), m_rigidbodies.end());
+    snapshot.positions.assign(m_bodies.positions.begin(), m_bodies.positions.end());
+    snapshot.rotations.assign(m_bodies.rotations.begin(), m_bodies.rotations.end());
+    snapshot.velocities.assign(m_bodies.velocities.begin(), m_bodies.velocities.end());
+    snapshot.angularVelocities.assign(m_bodies.angularVelocities.begin(), m_bodies.angularVelocities.end());
+    snapshot.forces.assign(m_bodies.forces.begin(), m_bodies.forces.end());
+    snapshot.torques.assign(m_bodies.torques.begin(), m_bodies.torques.end());
+    snapshot.sleepTimers.assign(m_sleepTimers.begin(), m_sleepTimers.end());
+    snapshot.sleepLinks.assign(m_sleepLinks.begin(), m_sleepLinks.end());
+
+    const int count = m_bodies.size();
+    snapshot.asleep.resize(count);
+    for (int i = 0; i < count; ++i) {
+        snapshot.asleep[i] = m_rigidbodies[i]->isAsleep() ? 1 : 0;
+    }
+
+    snapshot.manifolds.assign(m_manifoldCache.begin(), m_manifoldCache.end());
+    snapshot.contactPairs.assign(m_previousPairs.pairs.begin(), m_previousPairs.pairs.end());
+    snapshot.contactTriggers.assign(m_previousPairs.triggers.begin(), m_previousPairs.triggers.end());
+    snapshot.contactSlots.assign(m_previousPairs.slots.begin(), m_previousPairs.slots.end());
+}
+
+bool PhysicsWorld::restoreState(const PhysicsSnapshot& snapshot) {
+    if (snapshot.rigidbodies.size() != m_rigidbodies.size() ||
+        !std::equal(m_rigidbodies.begin(), m_rigidbodies.end(), snapshot.rigidbodies.begin())) {
+        LOG_WARN("快照的刚体集合与物理世界不一致，无法恢复");
+        return false;
+    }
+
+    std::copy(snapshot.positions.begin(), snapshot.positions.end(), m_bodies.positions.begin());
+    std::copy(snapshot.rotations.begin(), snapshot.rotations.end(), m_bodies.rotations.begin());
+    std::copy(snapshot.velocities.begin(), snapshot.velocities.end(), m_bodies.velocities.begin());
+    std::copy(snapshot.angularVelocities.begin(), snapshot.angularVelocities.end(), m_bodies.angularVelocities.begin());
+    std::copy(snapshot.forces.begin(), snapshot.forces.end(), m_bodies.forces.begin());
+    std::copy(snapshot.torques.begin(), snapshot.torques.end(), m_bodies.torques.begin());
+    std::copy(snapshot.sleepTimers.begin(), snapshot.sleepTimers.end(), m_sleepTimers.begin());
+    std::copy(snapshot.sleepLinks.begin(), snapshot.sleepLinks.end(), m_sleepLinks.begin());
+
+    // 只有位置或旋转与快照不同的Transform才写回，被标记移动后由下面的同步更新宽相代理
+    const int count = m_bodies.size();
+    for (int i = 0; i < count; ++i) {
+        m_rigidbodies[i]->m_asleep = snapshot.asleep[i] != 0;
+
+        Transform* transform = m_bodies.transforms[i];
+        if (!transform) {
+            continue;
+        }
+        const Vector2& position = transform->getPosition();
+        if (position.x != m_bodies.positions[i].x || position.y != m_bodies.positions[i].y) {
+            transform->setPosition(m_bodies.positions[i]);
+        }
+        if (transform->getRotation() != m_bodies.rotations[i]) {
+            transform->setRotation(m_bodies.rotations[i]);
+        }
+    }
+    syncTransforms();
+
+    m_manifoldCache.assign(snapshot.manifolds.begin(), snapshot.manifolds.end());
+    m_previousPairs.pairs.assign(snapshot.contactPairs.begin(), snapshot.contactPairs.end());
+    m_previousPairs.triggers.assign(snapshot.contactTriggers.begin(), snapshot.contactTriggers.end());
+    m_previousPairs.slots.assign(snapshot.contactSlots.begin(), snapshot.contactSlots.end());
+
+    // 本步的输出属于被回滚的时间线
+    m_contacts.clear();
+    m_manifolds.clear();
+    m_contactEvents.clear();
+    return true;
+}
+
+void PhysicsWorld::setProfilingEnabled(bool enabled) {
+    m_profilingEnabled = enabled;
+}
+
+bool PhysicsWorld::isProfilingEnabled() const {
+    return m_profilingEnabled;
+}
+
+void PhysicsWorld::integrateForces(float deltaTime) {
+    updateBodyMasks();
+
+    // 掩码为0的刚体增量为0，循环内没有分支
+    const int count = m_bodies.size();
+    for (int i = 0; i < count; ++i) {
+        const float step = deltaTime * m_bodies.simulated[i];
+        const Vector2 acceleration = m_gravity * m_bodies.gravityScales[i] + m_bodies.forces[i] * m_bodies.inverseMasses[i];
+        m_bodies.velocities[i] = (m_bodies.velocities[i] + acceleration * step) *
+                                 (1.0f / (1.0f + step * m_bodies.linearDampings[i]));
+        m_bodies.angularVelocities[i] = (m_bodies.angularVelocities[i] + m_bodies.torques[i] * m_bodies.inverseInertias[i] * step) /
+                                        (1.0f + step * m_bodies.rotating[i] * m_bodies.angularDampings[i]);
+    }
+
+    std::fill(m_bodies.forces.begin(), m_bodies.forces.end(), Vector2());
+    std::fill(m_bodies.torques.begin(), m_bodies.torques.end(), 0.0f);
+}
+
+void PhysicsWorld::detectCollisions() {
+    syncTransforms();
+
+    // 动态-动态碰撞对，不可碰撞层之间的碰撞对在进入窄相之前剔除。
+    // 宽相输出的顺序取决于代理的移动历史，指针地址每次运行也不同，这里按两侧的登记序号规范化并排序，
+    // 求解顺序只由场景的构建顺序和当前状态决定，回滚或重新运行后结果不变
+    m_broadphase->computePairs(m_pairBuffer);
+    m_keyedPairs.resize(m_pairBuffer.size());
+    for (size_t i = 0; i < m_pairBuffer.size(); ++i) {
+        BroadphasePair pair = m_pairBuffer[i];
+        uint32_t idA = getColliderId(pair.colliderA);
+        uint32_t idB = getColliderId(pair.colliderB);
+        if (idB < idA) {
+            std::swap(pair.colliderA, pair.colliderB);
+            std::swap(idA, idB);
+        }
+        m_keyedPairs[i].key = makePairKey(idA, idB);
+        m_keyedPairs[i].pair = pair;
+    }
+    std::sort(m_keyedPairs.begin(), m_keyedPairs.end(), [](const KeyedPair& a, const KeyedPair& b) {
+        return a.key < b.key;
+    });
+    for (size_t i = 0; i < m_keyedPairs.size(); ++i) {
+        m_pairBuffer[i] = m_keyedPairs[i].pair;
+    }
+    if (!m_layerMatrixFull) {
+        const size_t generated = m_pairBuffer.size();
+        m_pairBuffer.erase(std::remove_if(m_pairBuffer.begin(), m_pairBuffer.end(), [this](const BroadphasePair& pair) {
+            return !layersCollide(pair.colliderA, pair.colliderB);
+        }), m_pairBuffer.end());
+        m_stats.layerCulledPairs += static_cast<int>(generated - m_pairBuffer.size());
+    }
+
+    // 动态-静态碰撞对：用每个动态代理只查询可碰撞层的静态桶，静态-静态碰撞对永远不会产生。
+    // 被跳过的静态碰撞对只在记录性能数据时统计，统计需要额外查询被屏蔽的桶
+    const bool countStaticCulls = m_profilingEnabled && !m_layerMatrixFull;
+    for (auto collider : m_dynamicColliders) {
+        const AABB& aabb = m_broadphase->getAABB(m_proxyIds[collider].proxyId);
+        const uint32_t layers = m_layerMatrix[layerIndex(collider->getLayer())];
+        if (countStaticCulls && (m_staticLayers & ~layers) != 0) {
+            m_queryBuffer.clear();
+            queryStatic(aabb, ~layers, m_queryBuffer);
+            for (auto staticCollider : m_queryBuffer) {
+                if (staticCollider->getType() != ColliderType::TILEMAP) {
+                    ++m_stats.layerCulledPairs;
+                    continue;
+                }
+                static_cast<const TilemapCollider*>(staticCollider)->forEachRect(aabb, [this](int) {
+                    ++m_stats.layerCulledPairs;
+                });
+            }
+        }
+
+        m_queryBuffer.clear();
+        queryStatic(aabb, layers, m_queryBuffer);
+        for (auto staticCollider : m_queryBuffer) {
+            if (staticCollider->getType() != ColliderType::TILEMAP) {
+                m_pairBuffer.emplace_back(collider, staticCollider);
+                continue;
+            }
+            // 瓦片地图按网格查出与代理重叠的矩形，每个矩形单独成对，各自保存接触流形
+            static_cast<const TilemapCollider*>(staticCollider)->forEachRect(aabb, [&](int index) {
+                m_pairBuffer.emplace_back(collider, staticCollider, index);
+            });
+        }
+    }
+
+    // 过滤碰撞对并提取两侧的形状数据，每个碰撞对的结果写入各自的下标。
+    // syncTransforms已刷新移动过的Transform的世界变换与多边形缓存（包括静态碰撞体），工作线程中只有只读访问
+    const int pairCount = static_cast<int>(m_pairBuffer.size());
+    m_stats.pairCount = pairCount;
+    m_narrowphaseResults.resize(pairCount);
+    m_narrowphaseHits.assign(pairCount, 0);
+    m_narrowphaseManifolds.resize(pairCount);
+    m_narrowphasePoints.resize(pairCount);
+    m_narrowphaseShapes.resize(pairCount * 2);
+    runParallel(pairCount, NARROWPHASE_BATCH_SIZE, [this](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const BroadphasePair& pair = m_pairBuffer[i];
+            if (filterPair(pair)) {
+                m_narrowphaseHits[i] = 1;
+                buildColliderShape(pair.colliderA, m_narrowphaseShapes[i * 2]);
+                if (pair.subShape >= 0) {
+                    static_cast<const TilemapCollider*>(pair.colliderB)->buildRectShape(pair.subShape, m_narrowphaseShapes[i * 2 + 1]);
+                } else {
+                    buildColliderShape(pair.colliderB, m_narrowphaseShapes[i * 2 + 1]);
+                }
+            }
+        }
+    });
+
+    // 按形状组合分组，同一组内使用同一个窄相函数，循环中没有虚函数调用和类型分支
+    for (auto& batch : m_narrowphaseBatches) {
+        batch.clear();
+    }
+    for (int i = 0; i < pairCount; ++i) {
+        if (m_narrowphaseHits[i]) {
+            const int typeA = static_cast<int>(m_narrowphaseShapes[i * 2].type);
+            const int typeB = static_cast<int>(m_narrowphaseShapes[i * 2 + 1].type);
+            m_narrowphaseBatches[typeA * SHAPE_TYPE_COUNT + typeB].push_back(i);
+            ++m_stats.narrowphaseTests;
+        }
+    }
+
+    for (int batchIndex = 0; batchIndex < SHAPE_TYPE_COUNT * SHAPE_TYPE_COUNT; ++batchIndex) {
+        const std::vector<int>& batch = m_narrowphaseBatches[batchIndex];
+        const NarrowphaseFunction function = s_narrowphaseTable[batchIndex / SHAPE_TYPE_COUNT][batchIndex % SHAPE_TYPE_COUNT];
+        runParallel(static_cast<int>(batch.size()), NARROWPHASE_BATCH_SIZE, [this, &batch, function](int begin, int end) {
+            for (int k = begin; k < end; ++k) {
+                const int i = batch[k];
+                ContactPoints& contact = m_narrowphasePoints[i];
+                if (!function(m_narrowphaseShapes[i * 2], m_narrowphaseShapes[i * 2 + 1], contact)) {
+                    m_narrowphaseHits[i] = 0;
+                    continue;
+                }
+                fillCollisionInfo(m_pairBuffer[i].colliderA, m_pairBuffer[i].colliderB, contact, m_narrowphaseResults[i]);
+                buildManifold(m_narrowphaseResults[i], contact, m_pairBuffer[i].subShape, m_narrowphaseManifolds[i]);
+            }
+        });
+    }
+
+    // 按碰撞对顺序串行收集接触，结果与线程数无关
+    m_contacts.clear();
+    m_manifolds.clear();
+    for (int i = 0; i < pairCount; ++i) {
+        if (!m_narrowphaseHits[i]) {
+            continue;
+        }
+
+        const CollisionInfo& info = m_narrowphaseResults[i];
+        m_contacts.push_back(info);
+        m_manifolds.push_back(m_narrowphaseManifolds[i]);
+
+        // 活动物体接触到休眠物体时唤醒其整个岛
+        if (!info.colliderA->isTrigger() && !info.colliderB->isTrigger()) {
+            Rigidbody* bodyA = info.colliderA->getRigidbody();
+            Rigidbody* bodyB = info.colliderB->getRigidbody();
+            if (bodyA && bodyA->isAsleep()) {
+                wakeIsland(bodyA);
+            } else if (bodyB && bodyB->isAsleep()) {
+                wakeIsland(bodyB);
+            }
+        }
+    }
+}
+
+void PhysicsWorld::resolveCollisions() {
+    // 各岛之间没有共享的动态刚体，可以并行求解；岛内按接触顺序串行迭代
+    const int islandCount = static_cast<int>(m_solverIslands.size());
+    runParallel(islandCount, 1, [this](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            solveIsland(m_solverIslands[i]);
+        }
+    });
+
+    // 位置修正，防止物体逐渐下沉。修正写入状态数组，随积分结果一起写回Transform
+    for (const auto& manifold : m_manifolds) {
+        if (manifold.pointCount == 0) {
+            continue;
+        }
+
+        const float invMassA = manifold.indexA >= 0 ? m_bodies.inverseMasses[manifold.indexA] : 0.0f;
+        const float invMassB = manifold.indexB >= 0 ? m_bodies.inverseMasses[manifold.indexB] : 0.0f;
+        const float invMassSum = invMassA + invMassB;
+        if (invMassSum <= 0.0f) {
+            continue;
+        }
+
+        const float depth = std::max(manifold.points[0].penetration - POSITION_CORRECTION_SLOP, 0.0f);
+        const Vector2 correction = manifold.normal * (depth / invMassSum * POSITION_CORRECTION_PERCENT);
+        if (invMassA > 0.0f) {
+            m_bodies.positions[manifold.indexA] = m_bodies.positions[manifold.indexA] - correction * invMassA;
+        }
+        if (invMassB > 0.0f) {
+            m_bodies.positions[manifold.indexB] = m_bodies.positions[manifold.indexB] + correction * invMassB;
+        }
+    }
+
+    // 保存本步的累积冲量，下一步按碰撞体对查找并热启动
+    m_manifoldCache.clear();
+    for (const auto& manifold : m_manifolds) {
+        if (manifold.pointCount > 0) {
+            m_manifoldCache.push_back(manifold);
+        }
+    }
+    std::sort(m_manifoldCache.begin(), m_manifoldCache.end(), manifoldLess);
+}
+
+void PhysicsWorld::integrateVelocities(float deltaTime) {
+    // 记录启用CCD的刚体的起点，积分后再沿位移扫掠修正
+    m_ccdStarts.resize(m_ccdBodies.size());
+    for (size_t k = 0; k < m_ccdBodies.size(); ++k) {
+        m_ccdStarts[k] = m_bodies.positions[m_ccdBodies[k]];
+    }
+
+    const int count = m_bodies.size();
+    for (int i = 0; i < count; ++i) {
+        m_bodies.positions[i] = m_bodies.positions[i] + m_bodies.velocities[i] * (deltaTime * m_bodies.moving[i]);
+        m_bodies.rotations[i] += m_bodies.angularVelocities[i] * (deltaTime * m_bodies.rotating[i]);
+    }
+
+    for (size_t k = 0; k < m_ccdBodies.size(); ++k) {
+        integrateContinuous(m_ccdBodies[k], m_ccdStarts[k], deltaTime);
+    }
+}
+
+void PhysicsWorld::integrateContinuous(int index, const Vector2& start, float deltaTime) {
+    auto collidersIt = m_transformColliders.find(m_bodies.transforms[index]);
+    if (collidersIt == m_transformColliders.end()) {
+        return;
+    }
+
+    // 位移小于物体最小半尺寸时不可能穿透，跳过扫掠
+    Vector2 displacement = m_bodies.positions[index] - start;
+    float minHalfExtent = std::numeric_limits<float>::max();
+    for (auto collider : collidersIt->second) {
+        if (collider->isActive() && !collider->isTrigger()) {
+            const AABB aabb = computeAABB(collider);
+            minHalfExtent = std::min(minHalfExtent, std::min(aabb.max.x - aabb.min.x, aabb.max.y - aabb.min.y) * 0.5f);
+        }
+    }
+    if (minHalfExtent == std::numeric_limits<float>::max() || displacement.dot(displacement) <= minHalfExtent * minHalfExtent) {
+        return;
+    }
+
+    Rigidbody* body = m_rigidbodies[index];
+    Vector2 position = start;
+    Vector2 velocity = m_bodies.velocities[index];
+    float remainingTime = deltaTime;
+
+    // 碰撞体的包围盒仍基于积分前的Transform，需要平移到起点
+    const Vector2 transformOffset = start - m_bodies.transforms[index]->getPosition();
+
+    for (int substep = 0; substep < MAX_CCD_SUBSTEPS; ++substep) {
+        const float length = displacement.magnitude();
+        if (length <= 1e-6f) {
+            break;
+        }
+        const Vector2 direction = displacement / length;
+
+        // 找出所有碰撞体中最早的撞击
+        float hitDistance = length;
+        Vector2 hitNormal;
+        Collider* hitCollider = nullptr;
+        for (auto collider : collidersIt->second) {
+            if (!collider->isActive() || collider->isTrigger()) {
+                continue;
+            }
+            float distance;
+            Vector2 normal;
+            Collider* other;
+            if (sweepCollider(collider, position - start + transformOffset, direction, hitDistance, distance, normal, other)) {
+                hitDistance = distance;
+                hitNormal = normal;
+                hitCollider = other;
+            }
+        }
+
+        if (!hitCollider) {
+            position = position + displacement;
+            break;
+        }
+
+        // 推进到撞击前，去掉速度的法向分量（按弹性反弹），剩余时间继续子步
+        position = position + direction * std::max(0.0f, hitDistance - CCD_SLOP);
+        const float normalSpeed = velocity.dot(hitNormal);
+        if (normalSpeed < 0.0f) {
+            const Rigidbody* otherBody = hitCollider->getRigidbody();
+            const float restitution = std::min(body->getRestitution(), otherBody ? otherBody->getRestitution() : 0.0f);
+            velocity = velocity - hitNormal * ((1.0f + restitution) * normalSpeed);
+        }
+
+        remainingTime *= 1.0f - hitDistance / length;
+        displacement = velocity * remainingTime;
+    }
+
+    m_bodies.positions[index] = position;
+    m_bodies.velocities[index] = velocity;
+}
+
+bool PhysicsWorld::sweepCollider(Collider* collider, const Vector2& offset, const Vector2& direction, float maxDistance,
+                                 float& distance, Vector2& normal, Collider*& hitCollider) {
+    AABB aabb = computeAABB(collider);
+    aabb.min = aabb.min + offset;
+    aabb.max = aabb.max + offset;
+    const Vector2 center = aabb.center();
+    const Vector2 halfExtents = (aabb.max - aabb.min) * 0.5f;
+
+    // 扫掠包围盒覆盖整段位移
+    const Vector2 end = center + direction * maxDistance;
+    const AABB swept = AABB::merge(aabb, AABB(aabb.min + (end - center), aabb.max + (end - center)));
+    m_queryBuffer.clear();
+    queryStatic(swept, m_layerMatrix[layerIndex(collider->getLayer())], m_queryBuffer);
+    m_broadphase->query(swept, m_queryBuffer);
+
+    bool hit = false;
+    for (auto other : m_queryBuffer) {
+        if (other == collider || !other->isActive() || other->isTrigger() ||
+            other->getGameObject() == collider->getGameObject() || !layersCollide(collider, other) ||
+            !collider->collideWithLayer(other->getLayer()) || !other->collideWithLayer(collider->getLayer())) {
+            continue;
+        }
+
+        // 目标视为静止，形状按闵可夫斯基和膨胀后用射线求撞击时刻；
+        // 圆与圆精确求解，其余情况用包围盒膨胀（在角点处略为保守）
+        float candidateDistance;
+        Vector2 candidateNormal;
+        bool intersects;
+        if (collider->getType() == ColliderType::CIRCLE && other->getType() == ColliderType::CIRCLE) {
+            const auto circle = static_cast<const CircleCollider*>(collider);
+            const auto otherCircle = static_cast<const CircleCollider*>(other);
+            CircleShape expanded;
+            expanded.center = otherCircle->getCenter();
+            expanded.radius = circle->getRadius() + otherCircle->getRadius();
+            intersects = raycastCircle(expanded, center, direction, maxDistance, candidateDistance, candidateNormal);
+        } else if (other->getType() == ColliderType::TILEMAP) {
+            // 瓦片地图只检测与扫掠范围重叠的矩形，已重叠的矩形不影响更远的撞击
+            const auto tilemap = static_cast<const TilemapCollider*>(other);
+            intersects = false;
+            tilemap->forEachRect(swept, [&](int index) {
+                AABB target = tilemap->getRectBounds(index);
+                target.min = target.min - halfExtents;
+                target.max = target.max + halfExtents;
+                float rectDistance;
+                Vector2 rectNormal;
+                if (rayIntersectsAABB(center, direction, target, maxDistance, rectDistance, rectNormal) &&
+                    rectDistance > 0.0f && (!intersects || rectDistance < candidateDistance)) {
+                    candidateDistance = rectDistance;
+                    candidateNormal = rectNormal;
+                    intersects = true;
+                }
+            });
+        } else {
+            AABB target = computeAABB(other);
+            target.min = target.min - halfExtents;
+            target.max = target.max + halfExtents;
+            intersects = rayIntersectsAABB(center, direction, target, maxDistance, candidateDistance, candidateNormal);
+        }
+
+        // 起点已重叠的接触交给常规求解器处理
+        if (intersects && candidateDistance > 0.0f && candidateDistance < maxDistance) {
+            maxDistance = candidateDistance;
+            distance = candidateDistance;
+            normal = candidateNormal;
+            hitCollider = other;
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+void PhysicsWorld::updateBodyMasks() {
+    m_ccdBodies.clear();
+    const int count = m_bodies.size();
+    for (int i = 0; i < count; ++i) {
+        const Rigidbody* body = m_rigidbodies[i];
+        const bool moving = body->isActive() && !body->isAsleep() && body->getBodyType() != BodyType::STATIC &&
+                            m_bodies.transforms[i];
+        m_bodies.simulated[i] = moving && body->getBodyType() == BodyType::DYNAMIC ? 1.0f : 0.0f;
+        m_bodies.moving[i] = moving ? 1.0f : 0.0f;
+        m_bodies.rotating[i] = moving && !body->isFixedRotation() ? 1.0f : 0.0f;
+        if (moving && body->getBodyType() == BodyType::DYNAMIC && body->usesCCD()) {
+            m_ccdBodies.push_back(i);
+        }
+        m_stats.awakeBodyCount += moving ? 1 : 0;
+    }
+}
+
+void PhysicsWorld::writeBackTransforms() {
+    // 只有本步参与移动的刚体需要写回，休眠和静态刚体的Transform保持不变
+    const int count = m_bodies.size();
+    for (int i = 0; i < count; ++i) {
+        if (m_bodies.moving[i] == 0.0f) {
+            continue;
+        }
+
+        Transform* transform = m_bodies.transforms[i];
+        transform->setPosition(m_bodies.positions[i]);
+        if (m_bodies.rotating[i] != 0.0f) {
+            transform->setRotation(m_bodies.rotations[i]);
+        }
+    }
+}
+
+void PhysicsWorld::refreshBody(Rigidbody* rigidbody) {
+    const int index = getBodyIndex(rigidbody);
+    if (index < 0) {
+        return;
+    }
+
+    m_bodies.inverseMasses[index] = getInverseMass(rigidbody);
+    m_bodies.inverseInertias[index] = getInverseInertia(rigidbody);
+    m_bodies.gravityScales[index] = rigidbody->isAffectedByGravity() && rigidbody->getBodyType() == BodyType::DYNAMIC ?
+                                    rigidbody->getGravityScale() : 0.0f;
+    m_bodies.linearDampings[index] = rigidbody->getLinearDamping();
+    m_bodies.angularDampings[index] = rigidbody->getAngularDamping();
+
+    // 刚体类型变化可能使碰撞体在静态/动态分区之间迁移
+    auto it = m_transformColliders.find(m_bodies.transforms[index]);
+    if (it != m_transformColliders.end()) {
+        for (auto collider : it->second) {
+            auto proxyIt = m_proxyIds.find(collider);
+            if (proxyIt != m_proxyIds.end() && proxyIt->second.isStatic != isStaticCollider(collider)) {
+                updateCollider(collider);
+            }
+        }
+    }
+}
+
+int PhysicsWorld::getBodyIndex(const Rigidbody* rigidbody) const {
+    return rigidbody && rigidbody->m_world == this ? rigidbody->m_bodyIndex : -1;
+}
+
+void PhysicsWorld::updateProxy(Collider* collider) {
+    // 多边形的世界坐标缓存在这里串行刷新，窄相工作线程中才能只读访问。
+    // 静态碰撞体不更新宽相包围盒，但同样可能被游戏逻辑移动
+    if (collider->getType() == ColliderType::POLYGON) {
+        static_cast<const PolygonCollider*>(collider)->getWorldShape();
+    }
+
+    auto it = m_proxyIds.find(collider);
+    if (it != m_proxyIds.end() && !it->second.isStatic) {
+        // 静态碰撞体的包围盒只在显式调用updateCollider时重新计算
+        m_broadphase->moveProxy(it->second.proxyId, computeAABB(collider));
+    }
+}
+
+void PhysicsWorld::insertProxy(Collider* collider, uint32_t id) {
+    ProxyHandle handle;
+    handle.id = id;
+    handle.isStatic = isStaticCollider(collider);
+    handle.layer = layerIndex(collider->getLayer());
+    if (handle.isStatic) {
+        // 静态物体尺寸差异大且几乎不动，每层使用一棵不扩展的包围体树
+        std::unique_ptr<Broadphase>& bucket = m_staticBuckets[handle.layer];
+        if (!bucket) {
+            bucket = std::make_unique<DynamicTree>(0.0f);
+        }
+        handle.proxyId = bucket->createProxy(computeAABB(collider), collider);
+        m_staticLayers |= 1u << handle.layer;
+    } else {
+        handle.proxyId = m_broadphase->createProxy(computeAABB(collider), collider);
+        m_dynamicColliders.push_back(collider);
+    }
+    m_proxyIds[collider] = handle;
+}
+
+void PhysicsWorld::destroyProxy(Collider* collider) {
+    auto it = m_proxyIds.find(collider);
+    if (it == m_proxyIds.end()) {
+        return;
+    }
+
+    if (it->second.isStatic) {
+        Broadphase& bucket = *m_staticBuckets[it->second.layer];
+        bucket.destroyProxy(it->second.proxyId);
+        if (bucket.getProxyCount() == 0) {
+            m_staticLayers &= ~(1u << it->second.layer);
+        }
+    } else {
+        m_broadphase->destroyProxy(it->second.proxyId);
+        m_dynamicColliders.erase(std::remove(m_dynamicColliders.begin(), m_dynamicColliders.end(), collider),
+                                 m_dynamicColliders.end());
+    }
+    m_proxyIds.erase(it);
+}
+
+uint32_t PhysicsWorld::getColliderId(const Collider* collider) const {
+    auto it = m_proxyIds.find(const_cast<Collider*>(collider));
+    return it != m_proxyIds.end() ? it->second.id : 0;
+}
+
+void PhysicsWorld::queryStatic(const AABB& aabb, uint32_t layers, std::vector<Collider*>& results) const {
+    uint32_t buckets = m_staticLayers & layers;
+    for (int layer = 0; buckets != 0; ++layer, buckets >>= 1) {
+        if (buckets & 1u) {
+            m_staticBuckets[layer]->query(aabb, results);
+        }
+    }
+}
+
+bool PhysicsWorld::layersCollide(const Collider* colliderA, const Collider* colliderB) const {
+    return (m_layerMatrix[layerIndex(colliderA->getLayer())] >> layerIndex(colliderB->getLayer())) & 1u;
+}
+
+int PhysicsWorld::overlapShape(const ColliderShape& shape, bool pointQuery, Collider** results, int maxResults,
+                               uint32_t layerMask) {
+    if (!results || maxResults <= 0) {
+        return 0;
+    }
+
+    m_queryBuffer.clear();
+    const AABB bounds = computeShapeAABB(shape);
+    m_broadphase->query(bounds, m_queryBuffer);
+    queryStatic(bounds, layerMask, m_queryBuffer);
+
+    // 宽相给出的是（胖）包围盒重叠的候选，这里按层和实际形状过滤
+    int count = 0;
+    for (auto collider : m_queryBuffer) {
+        // 与静态桶和层矩阵一致，超出范围的层按第0层处理
+        if (!collider->isActive() || !((layerMask >> layerIndex(collider->getLayer())) & 1u)) {
+            continue;
+        }
+
+        ColliderShape candidate;
+        buildColliderShape(collider, candidate);
+        bool overlaps;
+        if (pointQuery) {
+            overlaps = containsPoint(candidate, shape.circle.center);
+        } else {
+            ContactPoints contact;
+            overlaps = collideShapes(shape, candidate, contact);
+        }
+
+        if (overlaps) {
+            results[count++] = collider;
+            if (count == maxResults) {
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+int PhysicsWorld::castBatch(const std::vector<Ray>& rays, float radius, const Vector2& halfExtents, bool boxCast,
+                            std::vector<RaycastHit>& hits, RaycastMode mode) {
+    hits.clear();
+    if (mode == RaycastMode::CLOSEST) {
+        hits.resize(rays.size());
+        for (size_t r = 0; r < rays.size(); ++r) {
+            hits[r].rayIndex = static_cast<int>(r);
+        }
+    }
+
+    // 候选包围盒按投射形状的尺寸膨胀后，形状投射也可以用射线做粗测
+    const Vector2 extents = boxCast ? halfExtents : Vector2(radius, radius);
+
+    // 按线段中点的Z序排列射线，相邻的射线在空间上也相邻。每组射线只用组内的总包围盒查询一次宽相，
+    // 候选也只与组内的射线做粗测，分散在整个场景中的射线不会让每条射线都去测试全部碰撞体
+    AABB centers;
+    m_castOrder.clear();
+    for (size_t r = 0; r < rays.size(); ++r) {
+        const Ray& ray = rays[r];
+        const Vector2 direction = ray.direction.normalized();
+        if (direction.x == 0.0f && direction.y == 0.0f) {
+            continue;
+        }
+        const Vector2 center = ray.origin + direction * (ray.maxDistance * 0.5f);
+        centers = m_castOrder.empty() ? AABB(center, center) : AABB::merge(centers, AABB(center, center));
+        m_castOrder.push_back(r);
+    }
+    for (uint64_t& entry : m_castOrder) {
+        const Ray& ray = rays[entry];
+        const Vector2 center = ray.origin + ray.direction.normalized() * (ray.maxDistance * 0.5f);
+        entry |= static_cast<uint64_t>(mortonCode(center, centers)) << 32;
+    }
+    std::sort(m_castOrder.begin(), m_castOrder.end());
+
+    const int orderCount = static_cast<int>(m_castOrder.size());
+    for (int groupStart = 0; groupStart < orderCount; groupStart += CAST_GROUP_SIZE) {
+        const int groupEnd = std::min(groupStart + CAST_GROUP_SIZE, orderCount);
+
+        // 本组射线的总包围盒和层掩码
+        AABB bounds;
+        uint32_t layers = 0;
+        for (int k = groupStart; k < groupEnd; ++k) {
+            const Ray& ray = rays[static_cast<uint32_t>(m_castOrder[k])];
+            layers |= ray.layerMask;
+            const Vector2 end = ray.origin + ray.direction.normalized() * ray.maxDistance;
+            const AABB segment(Vector2(std::min(ray.origin.x, end.x), std::min(ray.origin.y, end.y)),
+                               Vector2(std::max(ray.origin.x, end.x), std::max(ray.origin.y, end.y)));
+            bounds = k == groupStart ? segment : AABB::merge(bounds, segment);
+        }
+        bounds = AABB(bounds.min - extents, bounds.max + extents);
+
+        m_queryBuffer.clear();
+        m_broadphase->query(bounds, m_queryBuffer);
+        queryStatic(bounds, layers, m_queryBuffer);
+
+        // 提取候选的形状数据，包围盒按minX/minY/maxX/maxY分段存放并补齐到4的倍数
+        m_castColliders.clear();
+        m_castShapes.clear();
+        for (auto collider : m_queryBuffer) {
+            if (!collider->isActive() || collider->isTrigger()) {
+                continue;
+            }
+            m_castColliders.push_back(collider);
+            m_castShapes.emplace_back();
+            buildColliderShape(collider, m_castShapes.back());
+        }
+
+        const int count = static_cast<int>(m_castColliders.size());
+        const int paddedCount = (count + 3) & ~3;
+        m_castBounds.assign(paddedCount * 4, 0.0f);
+        m_castLayers.assign(paddedCount, 0u);
+        float* minX = m_castBounds.data();
+        float* minY = minX + paddedCount;
+        float* maxX = minY + paddedCount;
+        float* maxY = maxX + paddedCount;
+        for (int i = 0; i < count; ++i) {
+            const AABB aabb = computeShapeAABB(m_castShapes[i]);
+            minX[i] = aabb.min.x - extents.x;
+            minY[i] = aabb.min.y - extents.y;
+            maxX[i] = aabb.max.x + extents.x;
+            maxY[i] = aabb.max.y + extents.y;
+            m_castLayers[i] = 1u << layerIndex(m_castColliders[i]->getLayer());
+        }
+
+        for (int k = groupStart; k < groupEnd; ++k) {
+            const int r = static_cast<int>(static_cast<uint32_t>(m_castOrder[k]));
+            const Ray& ray = rays[r];
+            const Vector2 direction = ray.direction.normalized();
+
+            m_castCandidates.clear();
+            rayVsBounds(minX, minY, maxX, maxY, m_castLayers.data(), paddedCount, ray.origin,
+                        Vector2(safeInverse(direction.x), safeInverse(direction.y)), ray.maxDistance,
+                        ray.layerMask, m_castCandidates);
+
+            // 通过粗测的候选再做精确的形状测试
+            float closest = ray.maxDistance;
+            for (int index : m_castCandidates) {
+                const ColliderShape& shape = m_castShapes[index];
+                const float limit = mode == RaycastMode::CLOSEST ? closest : ray.maxDistance;
+                float distance;
+                Vector2 normal;
+                bool intersects;
+                if (boxCast) {
+                    intersects = boxCastShape(shape, halfExtents, ray.origin, direction, limit, distance, normal);
+                } else if (radius > 0.0f) {
+                    intersects = circleCastShape(shape, radius, ray.origin, direction, limit, distance, normal);
+                } else {
+                    intersects = raycastShape(shape, ray.origin, direction, limit, distance, normal);
+                }
+                if (!intersects) {
+                    continue;
+                }
+
+                RaycastHit hit;
+                hit.collider = m_castColliders[index];
+                hit.point = ray.origin + direction * distance;
+                hit.normal = normal;
+                hit.distance = distance;
+                hit.rayIndex = r;
+                if (mode == RaycastMode::ALL) {
+                    hits.push_back(hit);
+                } else if (!hits[r].collider || distance < closest) {
+                    hits[r] = hit;
+                    closest = distance;
+                }
+            }
+        }
+    }
+
+    if (mode == RaycastMode::ALL) {
+        // 分组打乱了射线的处理顺序，输出仍按射线顺序排列，同一射线的命中由近到远
+        std::sort(hits.begin(), hits.end(), [](const RaycastHit& a, const RaycastHit& b) {
+            return a.rayIndex != b.rayIndex ? a.rayIndex < b.rayIndex : a.distance < b.distance;
+        });
+        return static_cast<int>(hits.size());
+    }
+    return static_cast<int>(std::count_if(hits.begin(), hits.end(), [](const RaycastHit& hit) {
+        return hit.collider != nullptr;
+    }));
+}
+
+bool PhysicsWorld::filterPair(const BroadphasePair& pair) const {
+    Collider* a = pair.colliderA;
+    Collider* b = pair.colliderB;
+
+    if (!a->isActive() || !b->isActive() || a->getGameObject() == b->getGameObject()) {
+        return false;
+    }
+    if (!a->collideWithLayer(b->getLayer()) || !b->collideWithLayer(a->getLayer())) {
+        return false;
+    }
+
+    // 两侧都已休眠或静态时跳过，休眠的岛不产生任何开销
+    Rigidbody* bodyA = a->getRigidbody();
+    Rigidbody* bodyB = b->getRigidbody();
+    if (!isAwakeBody(bodyA) && !isAwakeBody(bodyB)) {
+        return false;
+    }
+
+    // 两个都没有动态刚体的碰撞体之间不需要检测（触发器除外）
+    const bool dynamicA = bodyA && bodyA->getBodyType() == BodyType::DYNAMIC;
+    const bool dynamicB = bodyB && bodyB->getBodyType() == BodyType::DYNAMIC;
+    if (!dynamicA && !dynamicB && !a->isTrigger() && !b->isTrigger()) {
+        return false;
+    }
+
+    return true;
+}
+
+void PhysicsWorld::buildIslands() {
+    const int bodyCount = static_cast<int>(m_rigidbodies.size());
+    m_islandParents.resize(bodyCount);
+    for (int i = 0; i < bodyCount; ++i) {
+        m_islandParents[i] = i;
+    }
+
+    // 只有两个活动的动态刚体之间的接触才连接岛，静态和运动学物体不传递
+    auto islandIndex = [this](Rigidbody* body) -> int {
+        const int index = getBodyIndex(body);
+        if (index < 0 || body->isAsleep() || m_bodies.inverseMasses[index] <= 0.0f) {
+            return -1;
+        }
+        return index;
+    };
+
+    const int contactCount = static_cast<int>(m_contacts.size());
+    m_contactIslands.assign(contactCount, -1);
+    for (int i = 0; i < contactCount; ++i) {
+        const CollisionInfo& contact = m_contacts[i];
+        if (contact.colliderA->isTrigger() || contact.colliderB->isTrigger()) {
+            continue;
+        }
+
+        const int indexA = islandIndex(contact.colliderA->getRigidbody());
+        const int indexB = islandIndex(contact.colliderB->getRigidbody());
+        if (indexA >= 0 && indexB >= 0) {
+            const int rootA = findIsland(indexA);
+            const int rootB = findIsland(indexB);
+            if (rootA != rootB) {
+                m_islandParents[std::max(rootA, rootB)] = std::min(rootA, rootB);
+            }
+        }
+        m_contactIslands[i] = indexA >= 0 ? indexA : indexB;
+    }
+
+    // 按岛对接触做计数排序，岛内保持原有接触顺序
+    m_islandContactStarts.assign(bodyCount + 1, 0);
+    for (int i = 0; i < contactCount; ++i) {
+        if (m_contactIslands[i] >= 0) {
+            m_contactIslands[i] = findIsland(m_contactIslands[i]);
+            ++m_islandContactStarts[m_contactIslands[i] + 1];
+        }
+    }
+
+    m_solverIslands.clear();
+    for (int i = 0; i < bodyCount; ++i) {
+        if (m_islandContactStarts[i + 1] > 0) {
+            m_solverIslands.push_back(i);
+        }
+        m_islandContactStarts[i + 1] += m_islandContactStarts[i];
+    }
+
+    m_islandContacts.resize(m_islandContactStarts[bodyCount]);
+    m_islandFill.assign(m_islandContactStarts.begin(), m_islandContactStarts.end() - 1);
+    for (int i = 0; i < contactCount; ++i) {
+        if (m_contactIslands[i] >= 0) {
+            m_islandContacts[m_islandFill[m_contactIslands[i]]++] = i;
+        }
+    }
+}
+
+void PhysicsWorld::buildManifold(const CollisionInfo& info, const ContactPoints& points, int subShape,
+                                 ContactManifold& manifold) const {
+    // 按登记序号规范化碰撞对，使缓存键与宽相输出的顺序无关
+    Collider* a = info.colliderA;
+    Collider* b = info.colliderB;
+    uint32_t idA = getColliderId(a);
+    uint32_t idB = getColliderId(b);
+    Vector2 normal = info.normal;
+    if (idB < idA) {
+        std::swap(a, b);
+        std::swap(idA, idB);
+        normal = normal * -1.0f;
+    }
+
+    manifold.colliderA = a;
+    manifold.colliderB = b;
+    manifold.subShape = subShape;
+    manifold.pairKey = makePairKey(idA, idB);
+    manifold.bodyA = a->getRigidbody();
+    manifold.bodyB = b->getRigidbody();
+    manifold.indexA = getBodyIndex(manifold.bodyA);
+    manifold.indexB = getBodyIndex(manifold.bodyB);
+    manifold.normal = normal;
+    manifold.pointCount = 0;
+    if (a->isTrigger() || b->isTrigger()) {
+        return;
+    }
+
+    manifold.friction = std::sqrt((manifold.bodyA ? manifold.bodyA->getFriction() : 0.0f) *
+                                  (manifold.bodyB ? manifold.bodyB->getFriction() : 0.0f));
+    manifold.restitution = std::min(manifold.bodyA ? manifold.bodyA->getRestitution() : 0.0f,
+                                    manifold.bodyB ? manifold.bodyB->getRestitution() : 0.0f);
+
+    // 接触点与特征编号直接取自窄相结果
+    for (int i = 0; i < points.pointCount; ++i) {
+        manifold.points[i].position = points.points[i];
+        manifold.points[i].penetration = points.penetrations[i];
+        manifold.points[i].id = points.ids[i];
+    }
+    manifold.pointCount = points.pointCount;
+
+    // 以刚体位置作为质心，没有刚体的一侧不转动，偏移无意义
+    const Vector2 centerA = manifold.indexA >= 0 ? m_bodies.positions[manifold.indexA] : manifold.points[0].position;
+    const Vector2 centerB = manifold.indexB >= 0 ? m_bodies.positions[manifold.indexB] : manifold.points[0].position;
+    for (int i = 0; i < manifold.pointCount; ++i) {
+        ManifoldPoint& point = manifold.points[i];
+        point.offsetA = point.position - centerA;
+        point.offsetB = point.position - centerB;
+        point.normalImpulse = 0.0f;
+        point.tangentImpulse = 0.0f;
+    }
+
+    // 从上一步的缓存中取回同一特征的累积冲量
+    auto it = std::lower_bound(m_manifoldCache.begin(), m_manifoldCache.end(), manifold, manifoldLess);
+    if (it == m_manifoldCache.end() || it->pairKey != manifold.pairKey || it->subShape != subShape) {
+        return;
+    }
+    for (int i = 0; i < manifold.pointCount; ++i) {
+        for (int j = 0; j < it->pointCount; ++j) {
+            if (it->points[j].id == manifold.points[i].id) {
+                manifold.points[i].normalImpulse = it->points[j].normalImpulse;
+                manifold.points[i].tangentImpulse = it->points[j].tangentImpulse;
+                break;
+            }
+        }
+    }
+}
+
+void PhysicsWorld::solveIsland(int island) {
+    const int begin = m_islandContactStarts[island];
+    const int end = m_islandContactStarts[island + 1];
+
+    for (int i = begin; i < end; ++i) {
+        prepareManifold(m_manifolds[m_islandContacts[i]]);
+    }
+
+    for (int iteration = 0; iteration < m_iterations; ++iteration) {
+        for (int i = begin; i < end; ++i) {
+            solveManifold(m_manifolds[m_islandContacts[i]]);
+        }
+    }
+}
+
+void PhysicsWorld::prepareManifold(ContactManifold& manifold) {
+    const int indexA = manifold.indexA;
+    const int indexB = manifold.indexB;
+    const float invMassA = indexA >= 0 ? m_bodies.inverseMasses[indexA] : 0.0f;
+    const float invMassB = indexB >= 0 ? m_bodies.inverseMasses[indexB] : 0.0f;
+    const float invInertiaA = indexA >= 0 ? m_bodies.inverseInertias[indexA] : 0.0f;
+    const float invInertiaB = indexB >= 0 ? m_bodies.inverseInertias[indexB] : 0.0f;
+    if (invMassA + invMassB <= 0.0f) {
+        manifold.pointCount = 0;
+        return;
+    }
+
+    Vector2 velocityA = indexA >= 0 ? m_bodies.velocities[indexA] : Vector2();
+    Vector2 velocityB = indexB >= 0 ? m_bodies.velocities[indexB] : Vector2();
+    float angularA = indexA >= 0 ? m_bodies.angularVelocities[indexA] : 0.0f;
+    float angularB = indexB >= 0 ? m_bodies.angularVelocities[indexB] : 0.0f;
+
+    const Vector2& normal = manifold.normal;
+    const Vector2 tangent(normal.y, -normal.x);
+
+    for (int i = 0; i < manifold.pointCount; ++i) {
+        ManifoldPoint& point = manifold.points[i];
+
+        const float rnA = point.offsetA.cross(normal);
+        const float rnB = point.offsetB.cross(normal);
+        const float normalMass = invMassA + invMassB + invInertiaA * rnA * rnA + invInertiaB * rnB * rnB;
+        point.normalMass = normalMass > 0.0f ? 1.0f / normalMass : 0.0f;
+
+        const float rtA = point.offsetA.cross(tangent);
+        const float rtB = point.offsetB.cross(tangent);
+        const float tangentMass = invMassA + invMassB + invInertiaA * rtA * rtA + invInertiaB * rtB * rtB;
+        point.tangentMass = tangentMass > 0.0f ? 1.0f / tangentMass : 0.0f;
+
+        // 弹性按热启动之前的接近速度计算
+        const Vector2 relativeVelocity = velocityB + crossScalar(angularB, point.offsetB) -
+                                         velocityA - crossScalar(angularA, point.offsetA);
+        const float approachSpeed = relativeVelocity.dot(normal);
+        point.velocityBias = approachSpeed < -RESTITUTION_THRESHOLD ? -manifold.restitution * approachSpeed : 0.0f;
+    }
+
+    // 两个接触点的法向约束联立求解，逐点迭代会在两点间来回传递冲量并引入虚假的转动
+    if (manifold.pointCount == 2) {
+        const float rn1A = manifold.points[0].offsetA.cross(normal);
+        const float rn1B = manifold.points[0].offsetB.cross(normal);
+        const float rn2A = manifold.points[1].offsetA.cross(normal);
+        const float rn2B = manifold.points[1].offsetB.cross(normal);
+        const float k11 = invMassA + invMassB + invInertiaA * rn1A * rn1A + invInertiaB * rn1B * rn1B;
+        const float k22 = invMassA + invMassB + invInertiaA * rn2A * rn2A + invInertiaB * rn2B * rn2B;
+        const float k12 = invMassA + invMassB + invInertiaA * rn1A * rn2A + invInertiaB * rn1B * rn2B;
+        const float determinant = k11 * k22 - k12 * k12;
+
+        if (k11 * k11 < MAX_CONDITION_NUMBER * determinant) {
+            manifold.normalMatrix[0] = k11;
+            manifold.normalMatrix[1] = k12;
+            manifold.normalMatrix[2] = k22;
+            manifold.normalMatrixInverse[0] = k22 / determinant;
+            manifold.normalMatrixInverse[1] = -k12 / determinant;
+            manifold.normalMatrixInverse[2] = k11 / determinant;
+        } else {
+            // 两点几乎重合，矩阵病态，退化为单点
+            manifold.pointCount = 1;
+        }
+    }
+
+    // 热启动：先施加上一步的累积冲量
+    for (int i = 0; i < manifold.pointCount; ++i) {
+        const ManifoldPoint& point = manifold.points[i];
+        const Vector2 impulse = normal * point.normalImpulse + tangent * point.tangentImpulse;
+        velocityA = velocityA - impulse * invMassA;
+        angularA -= invInertiaA * point.offsetA.cross(impulse);
+        velocityB = velocityB + impulse * invMassB;
+        angularB += invInertiaB * point.offsetB.cross(impulse);
+    }
+
+    // 运动学刚体可能被多个岛共享，只写回质量有限的一侧
+    storeVelocities(manifold, velocityA, angularA, velocityB, angularB);
+}
+
+void PhysicsWorld::solveManifold(ContactManifold& manifold) {
+    if (manifold.pointCount == 0) {
+        return;
+    }
+
+    const int indexA = manifold.indexA;
+    const int indexB = manifold.indexB;
+    const float invMassA = indexA >= 0 ? m_bodies.inverseMasses[indexA] : 0.0f;
+    const float invMassB = indexB >= 0 ? m_bodies.inverseMasses[indexB] : 0.0f;
+    const float invInertiaA = indexA >= 0 ? m_bodies.inverseInertias[indexA] : 0.0f;
+    const float invInertiaB = indexB >= 0 ? m_bodies.inverseInertias[indexB] : 0.0f;
+
+    Vector2 velocityA = indexA >= 0 ? m_bodies.velocities[indexA] : Vector2();
+    Vector2 velocityB = indexB >= 0 ? m_bodies.velocities[indexB] : Vector2();
+    float angularA = indexA >= 0 ? m_bodies.angularVelocities[indexA] : 0.0f;
+    float angularB = indexB >= 0 ? m_bodies.angularVelocities[indexB] : 0.0f;
+
+    const Vector2& normal = manifold.normal;
+    const Vector2 tangent(normal.y, -normal.x);
+
+    auto applyImpulse = [&](const ManifoldPoint& point, const Vector2& impulse) {
+        velocityA = velocityA - impulse * invMassA;
+        angularA -= invInertiaA * point.offsetA.cross(impulse);
+        velocityB = velocityB + impulse * invMassB;
+        angularB += invInertiaB * point.offsetB.cross(impulse);
+    };
+    auto relativeVelocity = [&](const ManifoldPoint& point) {
+        return velocityB + crossScalar(angularB, point.offsetB) - velocityA - crossScalar(angularA, point.offsetA);
+    };
+
+    // 先求解摩擦，摩擦上限取决于当前累积的法向冲量
+    for (int i = 0; i < manifold.pointCount; ++i) {
+        ManifoldPoint& point = manifold.points[i];
+        const float tangentSpeed = relativeVelocity(point).dot(tangent);
+        const float maxFriction = manifold.friction * point.normalImpulse;
+        const float newImpulse = std::max(-maxFriction, std::min(maxFriction, point.tangentImpulse - tangentSpeed * point.tangentMass));
+        const float lambda = newImpulse - point.tangentImpulse;
+        point.tangentImpulse = newImpulse;
+        applyImpulse(point, tangent * lambda);
+    }
+
+    // 法向冲量：对累积值而不是单次增量做非负截断
+    if (manifold.pointCount == 1) {
+        ManifoldPoint& point = manifold.points[0];
+        const float normalSpeed = relativeVelocity(point).dot(normal);
+        const float newImpulse = std::max(0.0f, point.normalImpulse - (normalSpeed - point.velocityBias) * point.normalMass);
+        const float lambda = newImpulse - point.normalImpulse;
+        point.normalImpulse = newImpulse;
+        applyImpulse(point, normal * lambda);
+    } else {
+        solveNormalBlock(manifold, relativeVelocity, applyImpulse);
+    }
+
+    storeVelocities(manifold, velocityA, angularA, velocityB, angularB);
+}
+
+template <typename RelativeVelocity, typename ApplyImpulse>
+void PhysicsWorld::solveNormalBlock(ContactManifold& manifold, const RelativeVelocity& relativeVelocity,
+                                    const ApplyImpulse& applyImpulse) {
+    // 线性互补问题 vn = K * x + b，要求 x >= 0、vn >= 0 且 x * vn = 0，
+    // 二维情形依次尝试四种互补组合即可精确求解
+    ManifoldPoint& point1 = manifold.points[0];
+    ManifoldPoint& point2 = manifold.points[1];
+    const float* k = manifold.normalMatrix;
+    const float* inverse = manifold.normalMatrixInverse;
+    const Vector2& normal = manifold.normal;
+
+    const float old1 = point1.normalImpulse;
+    const float old2 = point2.normalImpulse;
+    const float vn1 = relativeVelocity(point1).dot(normal);
+    const float vn2 = relativeVelocity(point2).dot(normal);
+    const float b1 = vn1 - point1.velocityBias - (k[0] * old1 + k[1] * old2);
+    const float b2 = vn2 - point2.velocityBias - (k[1] * old1 + k[2] * old2);
+
+    float x1;
+    float x2;
+    while (true) {
+        // 两点都受力
+        x1 = -(inverse[0] * b1 + inverse[1] * b2);
+        x2 = -(inverse[1] * b1 + inverse[2] * b2);
+        if (x1 >= 0.0f && x2 >= 0.0f) {
+            break;
+        }
+
+        // 只有第一点受力
+        x1 = -point1.normalMass * b1;
+        x2 = 0.0f;
+        if (x1 >= 0.0f && k[1] * x1 + b2 >= 0.0f) {
+            break;
+        }
+
+        // 只有第二点受力
+        x1 = 0.0f;
+        x2 = -point2.normalMass * b2;
+        if (x2 >= 0.0f && k[1] * x2 + b1 >= 0.0f) {
+            break;
+        }
+
+        // 两点都分离
+        x1 = 0.0f;
+        x2 = 0.0f;
+        if (b1 >= 0.0f && b2 >= 0.0f) {
+            break;
+        }
+
+        // 数值误差导致无解时保持原冲量
+        return;
+    }
+
+    applyImpulse(point1, normal * (x1 - old1));
+    applyImpulse(point2, normal * (x2 - old2));
+    point1.normalImpulse = x1;
+    point2.normalImpulse = x2;
+}
+
+void PhysicsWorld::storeVelocities(const ContactManifold& manifold, const Vector2& velocityA, float angularA,
+                                   const Vector2& velocityB, float angularB) {
+    if (manifold.indexA >= 0 && m_bodies.inverseMasses[manifold.indexA] > 0.0f) {
+        m_bodies.velocities[manifold.indexA] = velocityA;
+        m_bodies.angularVelocities[manifold.indexA] = angularA;
+    }
+    if (manifold.indexB >= 0 && m_bodies.inverseMasses[manifold.indexB] > 0.0f) {
+        m_bodies.velocities[manifold.indexB] = velocityB;
+        m_bodies.angularVelocities[manifold.indexB] = angularB;
+    }
+}
+
+void PhysicsWorld::runParallel(int count, int batchSize, const std::function<void(int, int)>& job) {
+    if (m_threadPool) {
+        m_threadPool->parallelFor(count, batchSize, job);
+    } else if (count > 0) {
+        job(0, count);
+    }
+}
+
+void PhysicsWorld::updateSleep(float deltaTime) {
+    if (!m_sleepingEnabled) {
+        return;
+    }
+
+    const int bodyCount = static_cast<int>(m_rigidbodies.size());
+    const float linearToleranceSq = m_linearSleepThreshold * m_linearSleepThreshold;
+
+    // 更新每个活动刚体的静止时间
+    for (int i = 0; i < bodyCount; ++i) {
+        Rigidbody* body = m_rigidbodies[i];
+        if (body->getBodyType() == BodyType::STATIC || body->isAsleep()) {
+            continue;
+        }
+
+        const Vector2& velocity = m_bodies.velocities[i];
+        const bool resting = body->canSleep() && body->getBodyType() == BodyType::DYNAMIC &&
+                             velocity.dot(velocity) <= linearToleranceSq &&
+                             std::fabs(m_bodies.angularVelocities[i]) <= m_angularSleepThreshold;
+        m_sleepTimers[i] = resting ? m_sleepTimers[i] + deltaTime : 0.0f;
+    }
+
+    // 岛已在求解前由buildIslands构建，岛的静止时间取岛内最小值，只有整个岛都静止足够久才休眠
+    m_islandSleepTimes.assign(bodyCount, std::numeric_limits<float>::max());
+    for (int i = 0; i < bodyCount; ++i) {
+        if (!isAwakeBody(m_rigidbodies[i])) {
+            continue;
+        }
+        const int root = findIsland(i);
+        m_islandSleepTimes[root] = std::min(m_islandSleepTimes[root], m_sleepTimers[i]);
+    }
+
+    m_islandSleepHeads.assign(bodyCount, -1);
+    for (int i = 0; i < bodyCount; ++i) {
+        Rigidbody* body = m_rigidbodies[i];
+        if (!isAwakeBody(body)) {
+            continue;
+        }
+
+        const int root = findIsland(i);
+        if (m_islandSleepTimes[root] < m_timeToSleep) {
+            continue;
+        }
+
+        // 同一个岛的刚体串成环形链表，之后按岛整体唤醒
+        int& head = m_islandSleepHeads[root];
+        if (head < 0) {
+            head = i;
+            m_sleepLinks[i] = i;
+        } else {
+            m_sleepLinks[i] = m_sleepLinks[head];
+            m_sleepLinks[head] = i;
+        }
+
+        body->m_asleep = true;
+        m_bodies.velocities[i] = Vector2();
+        m_bodies.angularVelocities[i] = 0.0f;
+    }
+}
+
+int PhysicsWorld::findIsland(int index) {
+    // 路径减半
+    while (m_islandParents[index] != index) {
+        m_islandParents[index] = m_islandParents[m_islandParents[index]];
+        index = m_islandParents[index];
+    }
+    return index;
+}
+
+std::unique_ptr<Broadphase> PhysicsWorld::createBroadphase(BroadphaseType type) const {
+    switch (type) {
+        case BroadphaseType::DYNAMIC_TREE:
+            return std::make_unique<DynamicTree>(m_broadphaseMargin);
+        case BroadphaseType::SWEEP_AND_PRUNE:
+            return std::make_unique<SweepAndPrune>();
+        case BroadphaseType::SPATIAL_HASH:
+        default:
+            return std::make_unique<SpatialHash>(m_broadphaseCellSize);
+    }
+}
+
+void PhysicsWorld::dispatchEvents() {
+    m_contactEvents.clear();
+    m_currentPairs.clear();
+
+    // 本步的接触在上一步集合中存在为持续，否则为开始
+    for (size_t i = 0; i < m_contacts.size(); ++i) {
+        const CollisionInfo& contact = m_contacts[i];
+
+        // 同一碰撞对的多个接触（瓦片地图的多个矩形）只产生一个事件
+        if (m_currentPairs.find(contact.colliderA, contact.colliderB) < 0) {
+            const bool trigger = contact.colliderA->isTrigger() || contact.colliderB->isTrigger();
+            const bool touching = m_previousPairs.find(contact.colliderA, contact.colliderB) >= 0;
+            m_currentPairs.insert(contact.colliderA, contact.colliderB, trigger);
+
+            std::vector<ContactEvent>& events = trigger
+                ? (touching ? m_contactEvents.triggerStay : m_contactEvents.triggerEnter)
+                : (touching ? m_contactEvents.collisionStay : m_contactEvents.collisionEnter);
+            events.emplace_back(contact.colliderA, contact.colliderB, static_cast<int>(i));
+        }
+
+        if (m_collisionCallback) {
+            m_collisionCallback(contact);
+        }
+    }
+
+    // 上一步接触而本步不再接触的碰撞对产生退出事件，类型沿用接触时的记录。
+    // 两侧都已休眠或静态的碰撞对被宽相过滤掉了，原样保留到下一步，唤醒后不会重复产生开始事件
+    for (int i = 0; i < m_previousPairs.size(); ++i) {
+        const BroadphasePair& pair = m_previousPairs.pairs[i];
+        if (m_currentPairs.find(pair.colliderA, pair.colliderB) >= 0) {
+            continue;
+        }
+        if (pair.colliderA->isActive() && pair.colliderB->isActive() &&
+            !isAwakeBody(pair.colliderA->getRigidbody()) && !isAwakeBody(pair.colliderB->getRigidbody())) {
+            m_currentPairs.insert(pair.colliderA, pair.colliderB, m_previousPairs.triggers[i] != 0);
+            continue;
+        }
+        std::vector<ContactEvent>& events = m_previousPairs.triggers[i]
+            ? m_contactEvents.triggerExit : m_contactEvents.collisionExit;
+        events.emplace_back(pair.colliderA, pair.colliderB, -1);
+    }
+
+    std::swap(m_previousPairs, m_currentPairs);
+
+    if (m_contactEventCallback) {
+        m_contactEventCallback(m_contactEvents);
+    }
+}
+
+size_t PhysicsSnapshot::getByteSize() const {
+    return rigidbodies.size() * sizeof(Rigidbody*) + positions.size() * sizeof(Vector2) +
+           rotations.size() * sizeof(float) + velocities.size() * sizeof(Vector2) +
+           angularVelocities.size() * sizeof(float) + forces.size() * sizeof(Vector2) +
+           torques.size() * sizeof(float) + sleepTimers.size() * sizeof(float) + sleepLinks.size() * sizeof(int) +
+           asleep.size() * sizeof(uint8_t) + manifolds.size() * sizeof(ContactManifold) +
+           contactPairs.size() * sizeof(BroadphasePair) + contactTriggers.size() * sizeof(char) +
+           contactSlots.size() * sizeof(int);
+}
+
+void ContactEvents::clear() {
+    collisionEnter.clear();
+    collisionStay.clear();
+    collisionExit.clear();
+    triggerEnter.clear();
+    triggerStay.clear();
+    triggerExit.clear();
+}
+
+int PhysicsWorld::ContactPairSet::find(Collider* a, Collider* b) const {
+    if (slots.empty()) {
+        return -1;
+    }
+    if (std::less<Collider*>()(b, a)) {
+        std::swap(a, b);
+    }
+
+    const size_t mask = slots.size() - 1;
+    for (size_t slot = hashPair(a, b) & mask;; slot = (slot + 1) & mask) {
+        const int index = slots[slot];
+        if (index < 0) {
+            return -1;
+        }
+        if (pairs[index].colliderA == a && pairs[index].colliderB == b) {
+            return index;
+        }
+    }
+}
+
+void PhysicsWorld::ContactPairSet::insert(Collider* a, Collider* b, bool trigger) {
+    if (std::less<Collider*>()(b, a)) {
+        std::swap(a, b);
+    }
+    pairs.emplace_back(a, b);
+    triggers.push_back(trigger ? 1 : 0);
+
+    // 装载率保持在一半以下，线性探测的链很短
+    if (pairs.size() * 2 > slots.size()) {
+        rehash(std::max<size_t>(slots.size() * 2, 64));
+        return;
+    }
+
+    const size_t mask = slots.size() - 1;
+    size_t slot = hashPair(a, b) & mask;
+    while (slots[slot] >= 0) {
+        slot = (slot + 1) & mask;
+    }
+    slots[slot] = static_cast<int>(pairs.size()) - 1;
+}
+
+void PhysicsWorld::ContactPairSet::remove(const Collider* collider) {
+    size_t count = 0;
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        if (pairs[i].colliderA != collider && pairs[i].colliderB != collider) {
+            pairs[count] = pairs[i];
+            triggers[count] = triggers[i];
+            ++count;
+        }
+    }
+    if (count != pairs.size()) {
+        pairs.resize(count);
+        triggers.resize(count);
+        rehash(slots.size());
+    }
+}
+
+void PhysicsWorld::ContactPairSet::clear() {
+    pairs.clear();
+    triggers.clear();
+    std::fill(slots.begin(), slots.end(), -1);
+}
+
+void PhysicsWorld::ContactPairSet::rehash(size_t slotCount) {
+    slots.assign(slotCount, -1);
+    const size_t mask = slotCount - 1;
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        size_t slot = hashPair(pairs[i].colliderA, pairs[i].colliderB) & mask;
+        while (slots[slot] >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = static_cast<int>(i);
+    }
+}
+
+void PhysicsWorld::BodyStates::push() {
+    transforms.push_back(nullptr);
+    positions.emplace_back();
+    rotations.push_back(0.0f);
+    velocities.emplace_back();
+    angularVelocities.push_back(0.0f);
+    forces.emplace_back();
+    torques.push_back(0.0f);
+    inverseMasses.push_back(0.0f);
+    inverseInertias.push_back(0.0f);
+    gravityScales.push_back(0.0f);
+    linearDampings.push_back(0.0f);
+    angularDampings.push_back(0.0f);
+    simulated.push_back(0.0f);
+    moving.push_back(0.0f);
+    rotating.push_back(0.0f);
+}
+
+void PhysicsWorld::BodyStates::swapRemove(int index) {
+    auto removeAt = [index](auto& values) {
+        values[index] = values.back();
+        values.pop_back();
+    };
+    removeAt(transforms);
+    removeAt(positions);
+    removeAt(rotations);
+    removeAt(velocities);
+    removeAt(angularVelocities);
+    removeAt(forces);
+    removeAt(torques);
+    removeAt(inverseMasses);
+    removeAt(inverseInertias);
+    removeAt(gravityScales);
+    removeAt(linearDampings);
+    removeAt(angularDampings);
+    removeAt(simulated);
+    removeAt(moving);
+    removeAt(rotating);
+}
+
+void PhysicsWorld::BodyStates::clear() {
+    transforms.clear();
+    positions.clear();
+    rotations.clear();
+    velocities.clear();
+    angularVelocities.clear();
+    forces.clear();
+    torques.clear();
+    inverseMasses.clear();
+    inverseInertias.clear();
+    gravityScales.clear();
+    linearDampings.clear();
+    angularDampings.clear();
+    simulated.clear();
+    moving.clear();
+    rotating.clear();
+}
+
+} // namespace Engine2D
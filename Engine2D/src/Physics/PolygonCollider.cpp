@@ -0,0 +1,171 @@
+#include "Engine2D/Physics/Collider.h"
+#include "Engine2D/Physics/PhysicsWorld.h"
+#include "Engine2D/Graphics/Renderer.h"
+#include "Engine2D/Graphics/SpriteBatch.h"
+#include "Engine2D/Core/Engine.h"
+#include "Engine2D/Utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Engine2D {
+
+PolygonCollider::PolygonCollider()
+    : m_cachedRotation(0.0f)
+    , m_worldShapeValid(false) {
+    setName("PolygonCollider");
+    setAsBox(1.0f, 1.0f);
+}
+
+PolygonCollider::PolygonCollider(const std::vector<Vector2>& vertices)
+    : m_cachedRotation(0.0f)
+    , m_worldShapeValid(false) {
+    setName("PolygonCollider");
+    if (!setVertices(vertices)) {
+        setAsBox(1.0f, 1.0f);
+    }
+}
+
+PolygonCollider::~PolygonCollider() {
+}
+
+ColliderType PolygonCollider::getType() const {
+    return ColliderType::POLYGON;
+}
+
+bool PolygonCollider::setVertices(const std::vector<Vector2>& vertices) {
+    if (vertices.size() < 3) {
+        LOG_WARN("多边形碰撞体至少需要3个顶点");
+        return false;
+    }
+
+    // 取凸包，结果按逆时针排列并去掉共线点
+    std::vector<Vector2> points(vertices);
+    std::vector<Vector2> hull(points.size() * 2);
+    hull.resize(computeConvexHull(points.data(), static_cast<int>(points.size()), hull.data()));
+
+    if (hull.size() < 3) {
+        LOG_WARN("多边形碰撞体的顶点退化为线段或点");
+        return false;
+    }
+    if (hull.size() > static_cast<size_t>(PolygonShape::MAX_VERTICES)) {
+        LOG_WARN("多边形碰撞体的凸包顶点数超过上限");
+        return false;
+    }
+
+    m_vertices = hull;
+    m_normals.resize(m_vertices.size());
+    for (size_t i = 0; i < m_vertices.size(); ++i) {
+        const Vector2 edge = m_vertices[(i + 1) % m_vertices.size()] - m_vertices[i];
+        m_normals[i] = Vector2(edge.y, -edge.x).normalized();
+    }
+    m_worldShapeValid = false;
+
+    // 已加入物理世界时刷新宽相包围盒
+    if (getTransform()) {
+        if (PhysicsWorld* world = Engine::getInstance().getPhysicsWorld()) {
+            world->updateCollider(this);
+        }
+    }
+    return true;
+}
+
+void PolygonCollider::setAsBox(float width, float height) {
+    const float halfWidth = width * 0.5f;
+    const float halfHeight = height * 0.5f;
+    setVertices({ Vector2(-halfWidth, -halfHeight), Vector2(halfWidth, -halfHeight),
+                  Vector2(halfWidth, halfHeight), Vector2(-halfWidth, halfHeight) });
+}
+
+const std::vector<Vector2>& PolygonCollider::getVertices() const {
+    return m_vertices;
+}
+
+const std::vector<Vector2>& PolygonCollider::getNormals() const {
+    return m_normals;
+}
+
+const PolygonShape& PolygonCollider::getWorldShape() const {
+    const Transform* transform = getTransform();
+    const Vector2 position = getCenter();
+    const float rotation = transform ? transform->getRotation() : 0.0f;
+    const Vector2 scale = transform ? transform->getScale() : Vector2(1.0f, 1.0f);
+
+    if (!m_worldShapeValid || position.x != m_cachedPosition.x || position.y != m_cachedPosition.y ||
+        rotation != m_cachedRotation || scale.x != m_cachedScale.x || scale.y != m_cachedScale.y) {
+        transformPolygon(m_vertices.data(), m_normals.data(), static_cast<int>(m_vertices.size()),
+                         position, rotation, scale, m_worldShape);
+        m_cachedPosition = position;
+        m_cachedRotation = rotation;
+        m_cachedScale = scale;
+        m_worldShapeValid = true;
+    }
+    return m_worldShape;
+}
+
+float PolygonCollider::computeInertia(float mass) const {
+    // 按三角形扇分解，求绕本地原点的面积惯性矩再乘以面密度
+    float area = 0.0f;
+    float inertia = 0.0f;
+    for (size_t i = 0; i < m_vertices.size(); ++i) {
+        const Vector2& a = m_vertices[i];
+        const Vector2& b = m_vertices[(i + 1) % m_vertices.size()];
+        const float cross = a.cross(b);
+        area += cross * 0.5f;
+        inertia += cross * (a.dot(a) + a.dot(b) + b.dot(b)) / 12.0f;
+    }
+    return area > 0.0f ? mass * inertia / area : 0.0f;
+}
+
+void PolygonCollider::getBoundingBox(Vector2& min, Vector2& max) const {
+    const AABB aabb = getWorldShape().getAABB();
+    min = aabb.min;
+    max = aabb.max;
+}
+
+bool PolygonCollider::checkCollision(Collider* other, CollisionInfo& info) const {
+    if (!other || other == this) {
+        return false;
+    }
+
+    ColliderShape shapeA;
+    ColliderShape shapeB;
+    buildColliderShape(this, shapeA);
+    buildColliderShape(other, shapeB);
+
+    ContactPoints contact;
+    if (!PhysicsWorld::collideShapes(shapeA, shapeB, contact)) {
+        return false;
+    }
+
+    info.colliderA = const_cast<PolygonCollider*>(this);
+    info.colliderB = other;
+    info.normal = contact.normal;
+    info.contactPoint = contact.points[0];
+    info.penetration = contact.penetrations[0];
+    if (contact.pointCount == 2) {
+        info.contactPoint = (contact.points[0] + contact.points[1]) * 0.5f;
+        info.penetration = std::max(contact.penetrations[0], contact.penetrations[1]);
+    }
+    return true;
+}
+
+void PolygonCollider::debugDraw() const {
+    Renderer* renderer = Engine::getInstance().getRenderer();
+    if (!renderer) {
+        return;
+    }
+
+    // 调试图形要盖在已提交的精灵上
+    if (SpriteBatch* batch = Engine::getInstance().getSpriteBatch()) {
+        batch->flush();
+    }
+
+    const PolygonShape& shape = getWorldShape();
+    for (int i = 0; i < shape.count; ++i) {
+        const Vector2& a = shape.vertices[i];
+        const Vector2& b = shape.vertices[(i + 1) % shape.count];
+        renderer->drawLine(a.x, a.y, b.x, b.y, isTrigger() ? Color::YELLOW : Color::GREEN);
+    }
+}
+
+} // namespace Engine2D
@@ -0,0 +1,318 @@
+#include "Engine2D/Physics/Rigidbody.h"
+#include "Engine2D/Physics/Collider.h"
+#include "Engine2D/Physics/PhysicsWorld.h"
+#include "Engine2D/Core/Engine.h"
+#include "Engine2D/Core/GameObject.h"
+#include <algorithm>
+
+namespace Engine2D {
+
+Rigidbody::Rigidbody(BodyType type)
+    : m_bodyType(type)
+    , m_mass(1.0f)
+    , m_inverseMass(1.0f)
+    , m_inertia(0.0f)
+    , m_inverseInertia(0.0f)
+    , m_linearDamping(0.0f)
+    , m_angularDamping(0.05f)
+    , m_gravityScale(1.0f)
+    , m_angularVelocity(0.0f)
+    , m_torque(0.0f)
+    , m_fixedRotation(false)
+    , m_affectedByGravity(true)
+    , m_friction(0.2f)
+    , m_restitution(0.0f)
+    , m_useCCD(false)
+    , m_asleep(false)
+    , m_canSleep(true)
+    , m_world(nullptr)
+    , m_bodyIndex(-1) {
+    setName("Rigidbody");
+}
+
+Rigidbody::~Rigidbody() {
+    if (m_world) {
+        m_world->removeRigidbody(this);
+    }
+}
+
+void Rigidbody::initialize() {
+    Component::initialize();
+    recalculateMassData();
+
+    if (PhysicsWorld* world = Engine::getInstance().getPhysicsWorld()) {
+        world->addRigidbody(this);
+    }
+}
+
+void Rigidbody::update(float deltaTime) {
+    // 运动由物理世界统一积分，组件本身不需要逐帧更新
+    Component::update(deltaTime);
+}
+
+void Rigidbody::destroy() {
+    if (m_world) {
+        m_world->removeRigidbody(this);
+    }
+    Component::destroy();
+}
+
+void Rigidbody::setBodyType(BodyType type) {
+    m_bodyType = type;
+    recalculateMassData();
+}
+
+BodyType Rigidbody::getBodyType() const {
+    return m_bodyType;
+}
+
+void Rigidbody::setMass(float mass) {
+    m_mass = std::max(0.0f, mass);
+    recalculateMassData();
+}
+
+float Rigidbody::getMass() const {
+    return m_mass;
+}
+
+float Rigidbody::getInverseInertia() const {
+    return m_fixedRotation ? 0.0f : m_inverseInertia;
+}
+
+void Rigidbody::setLinearDamping(float damping) {
+    m_linearDamping = std::max(0.0f, damping);
+    if (m_world) {
+        m_world->refreshBody(this);
+    }
+}
+
+float Rigidbody::getLinearDamping() const {
+    return m_linearDamping;
+}
+
+void Rigidbody::setAngularDamping(float damping) {
+    m_angularDamping = std::max(0.0f, damping);
+    if (m_world) {
+        m_world->refreshBody(this);
+    }
+}
+
+float Rigidbody::getAngularDamping() const {
+    return m_angularDamping;
+}
+
+void Rigidbody::setGravityScale(float scale) {
+    m_gravityScale = scale;
+    if (m_world) {
+        m_world->refreshBody(this);
+    }
+}
+
+float Rigidbody::getGravityScale() const {
+    return m_gravityScale;
+}
+
+void Rigidbody::setFixedRotation(bool fixed) {
+    m_fixedRotation = fixed;
+    if (fixed) {
+        setAngularVelocity(0.0f);
+    }
+    if (m_world) {
+        m_world->refreshBody(this);
+    }
+}
+
+bool Rigidbody::isFixedRotation() const {
+    return m_fixedRotation;
+}
+
+void Rigidbody::setVelocity(const Vector2& velocity) {
+    if (m_world) {
+        m_world->m_bodies.velocities[m_bodyIndex] = velocity;
+        if (m_asleep) {
+            m_world->wakeIsland(this);
+        }
+    } else {
+        m_velocity = velocity;
+    }
+}
+
+const Vector2& Rigidbody::getVelocity() const {
+    return m_world ? m_world->m_bodies.velocities[m_bodyIndex] : m_velocity;
+}
+
+void Rigidbody::setAngularVelocity(float angularVelocity) {
+    if (m_world) {
+        m_world->m_bodies.angularVelocities[m_bodyIndex] = angularVelocity;
+        if (m_asleep) {
+            m_world->wakeIsland(this);
+        }
+    } else {
+        m_angularVelocity = angularVelocity;
+    }
+}
+
+float Rigidbody::getAngularVelocity() const {
+    return m_world ? m_world->m_bodies.angularVelocities[m_bodyIndex] : m_angularVelocity;
+}
+
+void Rigidbody::applyForce(const Vector2& force, const Vector2& point) {
+    if (m_bodyType != BodyType::DYNAMIC) {
+        return;
+    }
+
+    // 作用点为零向量时视为作用于质心，不产生扭矩
+    float torque = 0.0f;
+    if ((point.x != 0.0f || point.y != 0.0f) && getTransform()) {
+        torque = (point - getTransform()->getPosition()).cross(force);
+    }
+
+    if (m_world) {
+        m_world->m_bodies.forces[m_bodyIndex] = m_world->m_bodies.forces[m_bodyIndex] + force;
+        m_world->m_bodies.torques[m_bodyIndex] += torque;
+        if (m_asleep) {
+            m_world->wakeIsland(this);
+        }
+    } else {
+        m_force = m_force + force;
+        m_torque += torque;
+    }
+}
+
+void Rigidbody::applyImpulse(const Vector2& impulse, const Vector2& point) {
+    if (m_bodyType != BodyType::DYNAMIC) {
+        return;
+    }
+
+    setVelocity(getVelocity() + impulse * m_inverseMass);
+    if ((point.x != 0.0f || point.y != 0.0f) && getTransform()) {
+        applyAngularImpulse((point - getTransform()->getPosition()).cross(impulse));
+    }
+    if (m_world && m_asleep) {
+        m_world->wakeIsland(this);
+    }
+}
+
+void Rigidbody::applyTorque(float torque) {
+    if (m_bodyType != BodyType::DYNAMIC) {
+        return;
+    }
+
+    if (m_world) {
+        m_world->m_bodies.torques[m_bodyIndex] += torque;
+        if (m_asleep) {
+            m_world->wakeIsland(this);
+        }
+    } else {
+        m_torque += torque;
+    }
+}
+
+void Rigidbody::applyAngularImpulse(float impulse) {
+    if (m_bodyType != BodyType::DYNAMIC) {
+        return;
+    }
+
+    setAngularVelocity(getAngularVelocity() + impulse * getInverseInertia());
+    if (m_world && m_asleep) {
+        m_world->wakeIsland(this);
+    }
+}
+
+void Rigidbody::setAffectedByGravity(bool affected) {
+    m_affectedByGravity = affected;
+    if (m_world) {
+        m_world->refreshBody(this);
+    }
+}
+
+bool Rigidbody::isAffectedByGravity() const {
+    return m_affectedByGravity;
+}
+
+void Rigidbody::setFriction(float friction) {
+    m_friction = std::max(0.0f, friction);
+}
+
+float Rigidbody::getFriction() const {
+    return m_friction;
+}
+
+void Rigidbody::setRestitution(float restitution) {
+    m_restitution = std::max(0.0f, std::min(1.0f, restitution));
+}
+
+float Rigidbody::getRestitution() const {
+    return m_restitution;
+}
+
+void Rigidbody::setUseCCD(bool use) {
+    m_useCCD = use;
+}
+
+bool Rigidbody::usesCCD() const {
+    return m_useCCD;
+}
+
+void Rigidbody::setAsleep(bool asleep) {
+    if (asleep == m_asleep) {
+        return;
+    }
+    if (!m_world) {
+        m_asleep = asleep;
+        return;
+    }
+
+    if (asleep) {
+        // 醒着的刚体不在任何休眠岛的环形链表中，单独休眠不会影响其他刚体
+        m_asleep = true;
+        m_world->m_bodies.velocities[m_bodyIndex] = Vector2();
+        m_world->m_bodies.angularVelocities[m_bodyIndex] = 0.0f;
+    } else {
+        // 从休眠岛中单独唤醒会留下指向自身的链接，因此整个岛一起唤醒
+        m_world->wakeIsland(this);
+    }
+}
+
+bool Rigidbody::isAsleep() const {
+    return m_asleep;
+}
+
+void Rigidbody::setCanSleep(bool canSleep) {
+    m_canSleep = canSleep;
+}
+
+bool Rigidbody::canSleep() const {
+    return m_canSleep;
+}
+
+void Rigidbody::recalculateMassData() {
+    if (m_bodyType != BodyType::DYNAMIC || m_mass <= 0.0f) {
+        m_inverseMass = 0.0f;
+        m_inertia = 0.0f;
+        m_inverseInertia = 0.0f;
+    } else {
+        m_inverseMass = 1.0f / m_mass;
+
+        // 转动惯量按附加的碰撞体形状计算，没有碰撞体时不转动
+        m_inertia = 0.0f;
+        if (GameObject* gameObject = getGameObject()) {
+            if (auto box = gameObject->getComponent<BoxCollider>()) {
+                const float width = box->getWidth();
+                const float height = box->getHeight();
+                m_inertia = m_mass * (width * width + height * height) / 12.0f;
+            } else if (auto circle = gameObject->getComponent<CircleCollider>()) {
+                m_inertia = 0.5f * m_mass * circle->getRadius() * circle->getRadius();
+            } else if (auto polygon = gameObject->getComponent<PolygonCollider>()) {
+                m_inertia = polygon->computeInertia(m_mass);
+            }
+        }
+        m_inverseInertia = m_inertia > 0.0f ? 1.0f / m_inertia : 0.0f;
+    }
+
+    if (m_world) {
+        m_world->refreshBody(this);
+    }
+}
+
+} // namespace Engine2D
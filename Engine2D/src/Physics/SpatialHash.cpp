@@ -0,0 +1,256 @@
+#include "Engine2D/Physics/SpatialHash.h"
+#include "Engine2D/Utils/Logger.h"
+#include <cmath>
+#include <algorithm>
+
+namespace Engine2D {
+
+namespace {
+    // 单个代理允许覆盖的最大网格单元数，超出时说明单元大小设置不合理
+    const int MAX_CELLS_PER_PROXY = 4096;
+}
+
+SpatialHash::SpatialHash(float cellSize)
+    : m_cellSize(cellSize > 0.0f ? cellSize : 64.0f)
+    , m_inverseCellSize(1.0f / m_cellSize)
+    , m_freeList(-1)
+    , m_proxyCount(0) {
+}
+
+SpatialHash::~SpatialHash() {
+    clear();
+}
+
+void SpatialHash::setCellSize(float cellSize) {
+    if (cellSize <= 0.0f || cellSize == m_cellSize) {
+        return;
+    }
+
+    m_cellSize = cellSize;
+    m_inverseCellSize = 1.0f / cellSize;
+
+    // 按新的单元大小重新登记所有代理
+    m_cells.clear();
+    for (int i = 0; i < static_cast<int>(m_proxies.size()); ++i) {
+        Proxy& proxy = m_proxies[i];
+        if (proxy.nextFree != -1) {
+            continue;
+        }
+        computeCellRange(proxy.aabb, proxy.minX, proxy.minY, proxy.maxX, proxy.maxY);
+        insertIntoCells(i);
+    }
+}
+
+float SpatialHash::getCellSize() const {
+    return m_cellSize;
+}
+
+BroadphaseType SpatialHash::getType() const {
+    return BroadphaseType::SPATIAL_HASH;
+}
+
+int SpatialHash::createProxy(const AABB& aabb, Collider* collider) {
+    int proxyId;
+    if (m_freeList != -1) {
+        proxyId = m_freeList;
+        m_freeList = m_proxies[proxyId].nextFree;
+    } else {
+        proxyId = static_cast<int>(m_proxies.size());
+        m_proxies.emplace_back();
+    }
+
+    Proxy& proxy = m_proxies[proxyId];
+    proxy.aabb = aabb;
+    proxy.collider = collider;
+    proxy.nextFree = -1;
+    computeCellRange(aabb, proxy.minX, proxy.minY, proxy.maxX, proxy.maxY);
+    insertIntoCells(proxyId);
+
+    ++m_proxyCount;
+    return proxyId;
+}
+
+void SpatialHash::destroyProxy(int proxyId) {
+    if (proxyId < 0 || proxyId >= static_cast<int>(m_proxies.size()) || m_proxies[proxyId].nextFree != -1) {
+        return;
+    }
+
+    removeFromCells(proxyId);
+
+    Proxy& proxy = m_proxies[proxyId];
+    proxy.collider = nullptr;
+    proxy.nextFree = m_freeList;
+    m_freeList = proxyId;
+    --m_proxyCount;
+}
+
+bool SpatialHash::moveProxy(int proxyId, const AABB& aabb) {
+    Proxy& proxy = m_proxies[proxyId];
+    proxy.aabb = aabb;
+
+    int minX, minY, maxX, maxY;
+    computeCellRange(aabb, minX, minY, maxX, maxY);
+    if (minX == proxy.minX && minY == proxy.minY && maxX == proxy.maxX && maxY == proxy.maxY) {
+        // 仍在相同的网格单元中，只需更新包围盒
+        return false;
+    }
+
+    removeFromCells(proxyId);
+    proxy.minX = minX;
+    proxy.minY = minY;
+    proxy.maxX = maxX;
+    proxy.maxY = maxY;
+    insertIntoCells(proxyId);
+    return true;
+}
+
+const AABB& SpatialHash::getAABB(int proxyId) const {
+    return m_proxies[proxyId].aabb;
+}
+
+Collider* SpatialHash::getCollider(int proxyId) const {
+    return m_proxies[proxyId].collider;
+}
+
+void SpatialHash::computePairs(std::vector<BroadphasePair>& pairs) const {
+    pairs.clear();
+
+    for (const auto& cell : m_cells) {
+        const std::vector<int>& ids = cell.second;
+        if (ids.size() < 2) {
+            continue;
+        }
+
+        const int cellX = static_cast<int32_t>(cell.first >> 32);
+        const int cellY = static_cast<int32_t>(cell.first & 0xFFFFFFFF);
+
+        for (size_t i = 0; i < ids.size(); ++i) {
+            const Proxy& a = m_proxies[ids[i]];
+            for (size_t j = i + 1; j < ids.size(); ++j) {
+                const Proxy& b = m_proxies[ids[j]];
+
+                // 两个代理可能同时出现在多个单元中，只在重叠区域的左下角单元报告一次
+                if (std::max(a.minX, b.minX) != cellX || std::max(a.minY, b.minY) != cellY) {
+                    continue;
+                }
+                if (!a.aabb.overlaps(b.aabb)) {
+                    continue;
+                }
+
+                if (ids[i] < ids[j]) {
+                    pairs.emplace_back(a.collider, b.collider);
+                } else {
+                    pairs.emplace_back(b.collider, a.collider);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::query(const AABB& aabb, std::vector<Collider*>& results) const {
+    int minX, minY, maxX, maxY;
+    computeCellRange(aabb, minX, minY, maxX, maxY);
+
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            auto it = m_cells.find(cellKey(x, y));
+            if (it == m_cells.end()) {
+                continue;
+            }
+
+            for (int proxyId : it->second) {
+                const Proxy& proxy = m_proxies[proxyId];
+
+                // 与计算碰撞对相同，只在重叠区域的左下角单元报告一次
+                if (std::max(proxy.minX, minX) != x || std::max(proxy.minY, minY) != y) {
+                    continue;
+                }
+                if (proxy.aabb.overlaps(aabb)) {
+                    results.push_back(proxy.collider);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::raycast(const Vector2& origin, const Vector2& direction, float maxDistance,
+                          const BroadphaseRaycastCallback& callback) const {
+    // 网格不支持按距离裁剪，直接查询射线段覆盖的区域
+    const Vector2 end = origin + direction * maxDistance;
+    const AABB segment(Vector2(std::min(origin.x, end.x), std::min(origin.y, end.y)),
+                       Vector2(std::max(origin.x, end.x), std::max(origin.y, end.y)));
+
+    m_raycastCandidates.clear();
+    query(segment, m_raycastCandidates);
+    for (auto collider : m_raycastCandidates) {
+        if (callback(collider) < 0.0f) {
+            return;
+        }
+    }
+}
+
+int SpatialHash::getProxyCount() const {
+    return m_proxyCount;
+}
+
+void SpatialHash::clear() {
+    m_cells.clear();
+    m_raycastCandidates.clear();
+    m_proxies.clear();
+    m_freeList = -1;
+    m_proxyCount = 0;
+}
+
+void SpatialHash::computeCellRange(const AABB& aabb, int& minX, int& minY, int& maxX, int& maxY) const {
+    minX = static_cast<int>(std::floor(aabb.min.x * m_inverseCellSize));
+    minY = static_cast<int>(std::floor(aabb.min.y * m_inverseCellSize));
+    maxX = static_cast<int>(std::floor(aabb.max.x * m_inverseCellSize));
+    maxY = static_cast<int>(std::floor(aabb.max.y * m_inverseCellSize));
+}
+
+void SpatialHash::insertIntoCells(int proxyId) {
+    const Proxy& proxy = m_proxies[proxyId];
+
+    const int64_t cellCount = static_cast<int64_t>(proxy.maxX - proxy.minX + 1) * (proxy.maxY - proxy.minY + 1);
+    if (cellCount > MAX_CELLS_PER_PROXY) {
+        LOG_WARN("空间哈希代理覆盖的网格单元过多，请考虑增大单元大小");
+    }
+
+    for (int y = proxy.minY; y <= proxy.maxY; ++y) {
+        for (int x = proxy.minX; x <= proxy.maxX; ++x) {
+            m_cells[cellKey(x, y)].push_back(proxyId);
+        }
+    }
+}
+
+void SpatialHash::removeFromCells(int proxyId) {
+    const Proxy& proxy = m_proxies[proxyId];
+
+    for (int y = proxy.minY; y <= proxy.maxY; ++y) {
+        for (int x = proxy.minX; x <= proxy.maxX; ++x) {
+            auto it = m_cells.find(cellKey(x, y));
+            if (it == m_cells.end()) {
+                continue;
+            }
+
+            // 单元内元素顺序无关紧要，直接与末尾交换删除
+            std::vector<int>& ids = it->second;
+            auto idIt = std::find(ids.begin(), ids.end(), proxyId);
+            if (idIt != ids.end()) {
+                *idIt = ids.back();
+                ids.pop_back();
+            }
+
+            // 空单元立即删除，否则单元表会随物体经过的区域不断增长，computePairs()每步都要遍历它们
+            if (ids.empty()) {
+                m_cells.erase(it);
+            }
+        }
+    }
+}
+
+int64_t SpatialHash::cellKey(int x, int y) {
+    return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y);
+}
+
+} // namespace Engine2D
@@ -0,0 +1,253 @@
+#include "Engine2D/Physics/SweepAndPrune.h"
+#include "Engine2D/Physics/Collider.h"
+#include <algorithm>
+
+namespace Engine2D {
+
+SweepAndPrune::SweepAndPrune(int axis)
+    : m_axis(axis == 1 ? 1 : 0)
+    , m_endpointsDirty(false)
+    , m_freeList(-1)
+    , m_proxyCount(0) {
+}
+
+SweepAndPrune::~SweepAndPrune() {
+    clear();
+}
+
+BroadphaseType SweepAndPrune::getType() const {
+    return BroadphaseType::SWEEP_AND_PRUNE;
+}
+
+void SweepAndPrune::setAxis(int axis) {
+    axis = axis == 1 ? 1 : 0;
+    if (axis == m_axis) {
+        return;
+    }
+
+    m_axis = axis;
+
+    // 新轴上的顺序与旧轴无关，整体重新排序一次
+    for (auto& endpoint : m_endpoints) {
+        const AABB& aabb = m_proxies[endpoint.proxyId].aabb;
+        endpoint.value = endpoint.isMin ? minOnAxis(aabb) : maxOnAxis(aabb);
+    }
+    std::stable_sort(m_endpoints.begin(), m_endpoints.end(), [](const Endpoint& a, const Endpoint& b) {
+        return a.value < b.value;
+    });
+}
+
+int SweepAndPrune::getAxis() const {
+    return m_axis;
+}
+
+int SweepAndPrune::createProxy(const AABB& aabb, Collider* collider) {
+    int proxyId;
+    if (m_freeList != -1) {
+        proxyId = m_freeList;
+        m_freeList = m_proxies[proxyId].nextFree;
+    } else {
+        proxyId = static_cast<int>(m_proxies.size());
+        m_proxies.emplace_back();
+    }
+
+    Proxy& proxy = m_proxies[proxyId];
+    proxy.aabb = aabb;
+    proxy.collider = collider;
+    proxy.activeIndex = -1;
+    proxy.nextFree = -1;
+    refreshFilter(proxy);
+
+    // 追加到末尾，下次排序时插入到正确位置
+    m_endpoints.push_back({ minOnAxis(aabb), proxyId, true });
+    m_endpoints.push_back({ maxOnAxis(aabb), proxyId, false });
+    m_endpointsDirty = true;
+
+    ++m_proxyCount;
+    return proxyId;
+}
+
+void SweepAndPrune::destroyProxy(int proxyId) {
+    if (proxyId < 0 || proxyId >= static_cast<int>(m_proxies.size()) || m_proxies[proxyId].nextFree != -1) {
+        return;
+    }
+
+    // 保持其余端点的相对顺序
+    m_endpoints.erase(std::remove_if(m_endpoints.begin(), m_endpoints.end(), [proxyId](const Endpoint& endpoint) {
+        return endpoint.proxyId == proxyId;
+    }), m_endpoints.end());
+
+    Proxy& proxy = m_proxies[proxyId];
+    proxy.collider = nullptr;
+    proxy.nextFree = m_freeList;
+    m_freeList = proxyId;
+    --m_proxyCount;
+}
+
+bool SweepAndPrune::moveProxy(int proxyId, const AABB& aabb) {
+    Proxy& proxy = m_proxies[proxyId];
+    proxy.aabb = aabb;
+    refreshFilter(proxy);
+    m_endpointsDirty = true;
+    return true;
+}
+
+const AABB& SweepAndPrune::getAABB(int proxyId) const {
+    return m_proxies[proxyId].aabb;
+}
+
+Collider* SweepAndPrune::getCollider(int proxyId) const {
+    return m_proxies[proxyId].collider;
+}
+
+void SweepAndPrune::computePairs(std::vector<BroadphasePair>& pairs) const {
+    pairs.clear();
+
+    sortEndpoints();
+
+    const int otherAxis = 1 - m_axis;
+    m_active.clear();
+
+    for (const auto& endpoint : m_endpoints) {
+        Proxy& proxy = m_proxies[endpoint.proxyId];
+
+        if (!endpoint.isMin) {
+            // 离开扫描区间，从活动列表中交换删除
+            const int index = proxy.activeIndex;
+            const int last = m_active.back();
+            m_active[index] = last;
+            m_proxies[last].activeIndex = index;
+            m_active.pop_back();
+            proxy.activeIndex = -1;
+            continue;
+        }
+
+        const float proxyMin = otherAxis == 0 ? proxy.aabb.min.x : proxy.aabb.min.y;
+        const float proxyMax = otherAxis == 0 ? proxy.aabb.max.x : proxy.aabb.max.y;
+
+        for (int otherId : m_active) {
+            const Proxy& other = m_proxies[otherId];
+
+            // 层过滤先于几何测试，不相互作用的层不会产生碰撞对
+            if (!(proxy.mask & other.layerBit) || !(other.mask & proxy.layerBit)) {
+                continue;
+            }
+
+            const float otherMin = otherAxis == 0 ? other.aabb.min.x : other.aabb.min.y;
+            const float otherMax = otherAxis == 0 ? other.aabb.max.x : other.aabb.max.y;
+            if (proxyMin > otherMax || proxyMax < otherMin) {
+                continue;
+            }
+
+            if (otherId < endpoint.proxyId) {
+                pairs.emplace_back(other.collider, proxy.collider);
+            } else {
+                pairs.emplace_back(proxy.collider, other.collider);
+            }
+        }
+
+        proxy.activeIndex = static_cast<int>(m_active.size());
+        m_active.push_back(endpoint.proxyId);
+    }
+}
+
+void SweepAndPrune::query(const AABB& aabb, std::vector<Collider*>& results) const {
+    // 上次排序后创建或移动过的代理端点可能无序或过期，先重新排序（几乎有序时接近线性）
+    if (m_endpointsDirty) {
+        sortEndpoints();
+    }
+
+    const float queryMin = minOnAxis(aabb);
+    const float queryMax = maxOnAxis(aabb);
+
+    // 端点有序，超过查询区间上界后即可停止
+    for (const auto& endpoint : m_endpoints) {
+        if (endpoint.value > queryMax) {
+            break;
+        }
+        if (!endpoint.isMin) {
+            continue;
+        }
+
+        const Proxy& proxy = m_proxies[endpoint.proxyId];
+        if (maxOnAxis(proxy.aabb) >= queryMin && proxy.aabb.overlaps(aabb)) {
+            results.push_back(proxy.collider);
+        }
+    }
+}
+
+void SweepAndPrune::raycast(const Vector2& origin, const Vector2& direction, float maxDistance,
+                            const BroadphaseRaycastCallback& callback) const {
+    const Vector2 end = origin + direction * maxDistance;
+    const AABB segment(Vector2(std::min(origin.x, end.x), std::min(origin.y, end.y)),
+                       Vector2(std::max(origin.x, end.x), std::max(origin.y, end.y)));
+
+    m_raycastCandidates.clear();
+    query(segment, m_raycastCandidates);
+    for (auto collider : m_raycastCandidates) {
+        if (callback(collider) < 0.0f) {
+            return;
+        }
+    }
+}
+
+int SweepAndPrune::getProxyCount() const {
+    return m_proxyCount;
+}
+
+void SweepAndPrune::clear() {
+    m_proxies.clear();
+    m_endpoints.clear();
+    m_active.clear();
+    m_raycastCandidates.clear();
+    m_endpointsDirty = false;
+    m_freeList = -1;
+    m_proxyCount = 0;
+}
+
+void SweepAndPrune::refreshFilter(Proxy& proxy) const {
+    if (proxy.collider) {
+        // 与PhysicsWorld的层矩阵一致，超出范围的层按第0层处理
+        const int layer = proxy.collider->getLayer();
+        proxy.layerBit = (layer >= 0 && layer < 32) ? (1u << layer) : 1u;
+        proxy.mask = proxy.collider->getCollisionMask();
+    } else {
+        proxy.layerBit = 0xFFFFFFFFu;
+        proxy.mask = 0xFFFFFFFFu;
+    }
+}
+
+void SweepAndPrune::sortEndpoints() const {
+    // 刷新端点坐标
+    for (auto& endpoint : m_endpoints) {
+        const AABB& aabb = m_proxies[endpoint.proxyId].aabb;
+        endpoint.value = endpoint.isMin ? minOnAxis(aabb) : maxOnAxis(aabb);
+    }
+
+    // 插入排序：帧间运动连贯时端点几乎有序，代价接近线性。
+    // 相等时最小端点排在最大端点之前，保证接触的包围盒也被报告
+    for (size_t i = 1; i < m_endpoints.size(); ++i) {
+        const Endpoint key = m_endpoints[i];
+        size_t j = i;
+        while (j > 0) {
+            const Endpoint& previous = m_endpoints[j - 1];
+            if (previous.value < key.value || (previous.value == key.value && (previous.isMin || !key.isMin))) {
+                break;
+            }
+            m_endpoints[j] = previous;
+            --j;
+        }
+        m_endpoints[j] = key;
+    }
+    m_endpointsDirty = false;
+}
+
+float SweepAndPrune::minOnAxis(const AABB& aabb) const {
+    return m_axis == 0 ? aabb.min.x : aabb.min.y;
+}
+
+float SweepAndPrune::maxOnAxis(const AABB& aabb) const {
+    return m_axis == 0 ? aabb.max.x : aabb.max.y;
+}
+
+} // namespace Engine2D
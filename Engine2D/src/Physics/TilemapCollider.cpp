@@ -0,0 +1,336 @@
+#include "Engine2D/Physics/Collider.h"
+#include "Engine2D/Physics/PhysicsWorld.h"
+#include "Engine2D/Graphics/Renderer.h"
+#include "Engine2D/Graphics/SpriteBatch.h"
+#include "Engine2D/Core/Engine.h"
+#include "Engine2D/Utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Engine2D {
+
+TilemapCollider::TilemapCollider(int width, int height, float tileSize)
+    : m_width(0)
+    , m_height(0)
+    , m_tileSize(tileSize > 0.0f ? tileSize : 32.0f)
+    , m_dirty(false) {
+    setName("TilemapCollider");
+    setTiles(width, height, std::vector<uint8_t>());
+}
+
+TilemapCollider::~TilemapCollider() {
+}
+
+void TilemapCollider::update(float deltaTime) {
+    Collider::update(deltaTime);
+    if (m_dirty) {
+        rebuild();
+    }
+}
+
+ColliderType TilemapCollider::getType() const {
+    return ColliderType::TILEMAP;
+}
+
+void TilemapCollider::setTiles(int width, int height, const std::vector<uint8_t>& solid) {
+    if (width < 0 || height < 0) {
+        LOG_WARN("瓦片地图的尺寸不能为负");
+        width = 0;
+        height = 0;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_tiles.assign(static_cast<size_t>(width) * height, 0);
+    const size_t count = std::min(solid.size(), m_tiles.size());
+    for (size_t i = 0; i < count; ++i) {
+        m_tiles[i] = solid[i] ? 1 : 0;
+    }
+    rebuild();
+}
+
+void TilemapCollider::setTile(int x, int y, bool solid) {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) {
+        return;
+    }
+
+    uint8_t& tile = m_tiles[y * m_width + x];
+    if ((tile != 0) != solid) {
+        tile = solid ? 1 : 0;
+        m_dirty = true;
+    }
+}
+
+bool TilemapCollider::isSolid(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) {
+        return false;
+    }
+    return m_tiles[y * m_width + x] != 0;
+}
+
+int TilemapCollider::getWidth() const {
+    return m_width;
+}
+
+int TilemapCollider::getHeight() const {
+    return m_height;
+}
+
+void TilemapCollider::setTileSize(float tileSize) {
+    if (tileSize <= 0.0f || tileSize == m_tileSize) {
+        return;
+    }
+    m_tileSize = tileSize;
+    rebuild();
+}
+
+float TilemapCollider::getTileSize() const {
+    return m_tileSize;
+}
+
+void TilemapCollider::rebuild() {
+    mergeRects();
+    m_dirty = false;
+
+    // 合并结果和包围盒都可能变化，静态代理需要显式更新
+    if (PhysicsWorld* world = Engine::getInstance().getPhysicsWorld()) {
+        world->updateCollider(this);
+    }
+}
+
+int TilemapCollider::getRectCount() const {
+    return static_cast<int>(m_rects.size());
+}
+
+const TilemapCollider::TileRect& TilemapCollider::getRect(int index) const {
+    return m_rects[index];
+}
+
+AABB TilemapCollider::getRectBounds(int index) const {
+    const TileRect& rect = m_rects[index];
+    const Vector2 origin = getCenter();
+    const Vector2 min(origin.x + rect.x * m_tileSize, origin.y + rect.y * m_tileSize);
+    return AABB(min, Vector2(min.x + rect.width * m_tileSize, min.y + rect.height * m_tileSize));
+}
+
+void TilemapCollider::buildRectShape(int index, ColliderShape& shape) const {
+    const AABB bounds = getRectBounds(index);
+    shape.type = ColliderType::BOX;
+    shape.box.center = bounds.center();
+    shape.box.halfExtents = (bounds.max - bounds.min) * 0.5f;
+    shape.box.rotation = 0.0f;
+}
+
+bool TilemapCollider::worldToTile(const Vector2& point, int& x, int& y) const {
+    const Vector2 local = (point - getCenter()) / m_tileSize;
+    x = static_cast<int>(std::floor(local.x));
+    y = static_cast<int>(std::floor(local.y));
+    return x >= 0 && y >= 0 && x < m_width && y < m_height;
+}
+
+bool TilemapCollider::raycast(const Vector2& origin, const Vector2& direction, float maxDistance,
+                              float& distance, Vector2& normal) const {
+    if (m_rects.empty()) {
+        return false;
+    }
+
+    // 先把射线裁剪到地图范围内，进入点的法线取自进入的那一侧
+    Vector2 min;
+    Vector2 max;
+    getBoundingBox(min, max);
+    float tMin = 0.0f;
+    float tMax = maxDistance;
+    Vector2 entryNormal;
+    const float origins[2] = { origin.x, origin.y };
+    const float directions[2] = { direction.x, direction.y };
+    const float mins[2] = { min.x, min.y };
+    const float maxs[2] = { max.x, max.y };
+    for (int axis = 0; axis < 2; ++axis) {
+        if (std::fabs(directions[axis]) < 1e-8f) {
+            if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) {
+                return false;
+            }
+            continue;
+        }
+
+        const float inverse = 1.0f / directions[axis];
+        float t1 = (mins[axis] - origins[axis]) * inverse;
+        float t2 = (maxs[axis] - origins[axis]) * inverse;
+        float sign = -1.0f;
+        if (t1 > t2) {
+            std::swap(t1, t2);
+            sign = 1.0f;
+        }
+        if (t1 > tMin) {
+            tMin = t1;
+            entryNormal = axis == 0 ? Vector2(sign, 0.0f) : Vector2(0.0f, sign);
+        }
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax) {
+            return false;
+        }
+    }
+
+    // 进入点所在的格子，落在最大边界上时归入最后一格
+    const Vector2 entry = origin + direction * tMin;
+    int x = std::min(std::max(static_cast<int>(std::floor((entry.x - min.x) / m_tileSize)), 0), m_width - 1);
+    int y = std::min(std::max(static_cast<int>(std::floor((entry.y - min.y) / m_tileSize)), 0), m_height - 1);
+    if (m_cellRects[y * m_width + x] >= 0) {
+        distance = tMin;
+        normal = entryNormal;
+        return true;
+    }
+
+    // 逐格前进，每次跨过最近的一条格线
+    const float infinity = std::numeric_limits<float>::infinity();
+    const int stepX = direction.x > 0.0f ? 1 : -1;
+    const int stepY = direction.y > 0.0f ? 1 : -1;
+    const float deltaX = direction.x != 0.0f ? m_tileSize / std::fabs(direction.x) : infinity;
+    const float deltaY = direction.y != 0.0f ? m_tileSize / std::fabs(direction.y) : infinity;
+    float nextX = direction.x != 0.0f ? (min.x + (x + (stepX > 0 ? 1 : 0)) * m_tileSize - origin.x) / direction.x : infinity;
+    float nextY = direction.y != 0.0f ? (min.y + (y + (stepY > 0 ? 1 : 0)) * m_tileSize - origin.y) / direction.y : infinity;
+
+    while (true) {
+        float t;
+        if (nextX < nextY) {
+            t = nextX;
+            nextX += deltaX;
+            x += stepX;
+            normal = Vector2(static_cast<float>(-stepX), 0.0f);
+        } else {
+            t = nextY;
+            nextY += deltaY;
+            y += stepY;
+            normal = Vector2(0.0f, static_cast<float>(-stepY));
+        }
+
+        if (t > tMax || x < 0 || y < 0 || x >= m_width || y >= m_height) {
+            return false;
+        }
+        if (m_cellRects[y * m_width + x] >= 0) {
+            distance = t;
+            return true;
+        }
+    }
+}
+
+bool TilemapCollider::containsPoint(const Vector2& point) const {
+    int x;
+    int y;
+    return worldToTile(point, x, y) && m_cellRects[y * m_width + x] >= 0;
+}
+
+void TilemapCollider::getBoundingBox(Vector2& min, Vector2& max) const {
+    min = getCenter();
+    max = Vector2(min.x + m_width * m_tileSize, min.y + m_height * m_tileSize);
+}
+
+bool TilemapCollider::checkCollision(Collider* other, CollisionInfo& info) const {
+    if (!other || other == this) {
+        return false;
+    }
+
+    ColliderShape shapeA;
+    ColliderShape shapeB;
+    buildColliderShape(this, shapeA);
+    buildColliderShape(other, shapeB);
+
+    ContactPoints contact;
+    if (!PhysicsWorld::collideShapes(shapeA, shapeB, contact)) {
+        return false;
+    }
+
+    info.colliderA = const_cast<TilemapCollider*>(this);
+    info.colliderB = other;
+    info.normal = contact.normal;
+    info.contactPoint = contact.points[0];
+    info.penetration = contact.penetrations[0];
+    if (contact.pointCount == 2) {
+        info.contactPoint = (contact.points[0] + contact.points[1]) * 0.5f;
+        info.penetration = std::max(contact.penetrations[0], contact.penetrations[1]);
+    }
+    return true;
+}
+
+void TilemapCollider::debugDraw() const {
+    Renderer* renderer = Engine::getInstance().getRenderer();
+    if (!renderer) {
+        return;
+    }
+
+    // 调试图形要盖在已提交的精灵上
+    if (SpriteBatch* batch = Engine::getInstance().getSpriteBatch()) {
+        batch->flush();
+    }
+
+    for (int i = 0; i < getRectCount(); ++i) {
+        const AABB bounds = getRectBounds(i);
+        renderer->drawRect(bounds.min.x, bounds.min.y, bounds.max.x - bounds.min.x, bounds.max.y - bounds.min.y,
+                           isTrigger() ? Color::YELLOW : Color::GREEN, false);
+    }
+}
+
+void TilemapCollider::mergeRects() {
+    m_rects.clear();
+    m_cellRects.assign(m_tiles.size(), -1);
+
+    for (int y = 0; y < m_height; ++y) {
+        for (int x = 0; x < m_width; ++x) {
+            const int start = y * m_width + x;
+            if (!m_tiles[start] || m_cellRects[start] >= 0) {
+                continue;
+            }
+
+            // 沿行向右延伸到第一个空格子或已合并的格子
+            int width = 1;
+            while (x + width < m_width && m_tiles[start + width] && m_cellRects[start + width] < 0) {
+                ++width;
+            }
+
+            // 下一行的同一段全部可用时整段向下延伸
+            int height = 1;
+            while (y + height < m_height) {
+                const int row = start + height * m_width;
+                bool usable = true;
+                for (int i = 0; i < width && usable; ++i) {
+                    usable = m_tiles[row + i] && m_cellRects[row + i] < 0;
+                }
+                if (!usable) {
+                    break;
+                }
+                ++height;
+            }
+
+            const int index = static_cast<int>(m_rects.size());
+            m_rects.push_back({ x, y, width, height });
+            for (int row = 0; row < height; ++row) {
+                std::fill_n(m_cellRects.begin() + start + row * m_width, width, index);
+            }
+        }
+    }
+}
+
+bool TilemapCollider::getTileRange(const AABB& area, int& minX, int& minY, int& maxX, int& maxY) const {
+    if (m_rects.empty()) {
+        return false;
+    }
+
+    const Vector2 origin = getCenter();
+    const float inverse = 1.0f / m_tileSize;
+    const float left = (area.min.x - origin.x) * inverse;
+    const float top = (area.min.y - origin.y) * inverse;
+    const float right = (area.max.x - origin.x) * inverse;
+    const float bottom = (area.max.y - origin.y) * inverse;
+    if (right < 0.0f || bottom < 0.0f || left > m_width || top > m_height) {
+        return false;
+    }
+
+    minX = std::max(static_cast<int>(std::floor(left)), 0);
+    minY = std::max(static_cast<int>(std::floor(top)), 0);
+    maxX = std::min(static_cast<int>(std::floor(right)), m_width - 1);
+    maxY = std::min(static_cast<int>(std::floor(bottom)), m_height - 1);
+    return minX <= maxX && minY <= maxY;
+}
+
+} // namespace Engine2D
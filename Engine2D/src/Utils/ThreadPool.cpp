@@ -0,0 +1,108 @@
+#include "Engine2D/Utils/ThreadPool.h"
+#include <algorithm>
+
+namespace Engine2D {
+
+ThreadPool::ThreadPool(int threadCount)
+    : m_job(nullptr)
+    , m_count(0)
+    , m_batchSize(1)
+    , m_nextBatch(0)
+    , m_batchCount(0)
+    , m_busyWorkers(0)
+    , m_generation(0)
+    , m_stopping(false) {
+    for (int i = 0; i < threadCount; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeWorkers.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+int ThreadPool::getThreadCount() const {
+    return static_cast<int>(m_workers.size());
+}
+
+void ThreadPool::parallelFor(int count, int batchSize, const RangeJob& job) {
+    if (count <= 0) {
+        return;
+    }
+
+    batchSize = std::max(1, batchSize);
+
+    // 没有工作线程或只有一个批次时直接在调用线程执行
+    if (m_workers.empty() || count <= batchSize) {
+        job(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_count = count;
+        m_batchSize = batchSize;
+        m_batchCount = (count + batchSize - 1) / batchSize;
+        m_nextBatch.store(0);
+        m_busyWorkers = static_cast<int>(m_workers.size());
+        ++m_generation;
+    }
+    m_wakeWorkers.notify_all();
+
+    runBatches();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobDone.wait(lock, [this]() { return m_busyWorkers == 0; });
+    m_job = nullptr;
+}
+
+void ThreadPool::workerLoop() {
+    unsigned int seenGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeWorkers.wait(lock, [this, seenGeneration]() {
+                return m_stopping || m_generation != seenGeneration;
+            });
+            if (m_stopping) {
+                return;
+            }
+            seenGeneration = m_generation;
+        }
+
+        runBatches();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_busyWorkers;
+        }
+        m_jobDone.notify_one();
+    }
+}
+
+void ThreadPool::runBatches() {
+    while (true) {
+        const int batch = m_nextBatch.fetch_add(1);
+        if (batch >= m_batchCount) {
+            return;
+        }
+
+        const int begin = batch * m_batchSize;
+        const int end = std::min(begin + m_batchSize, m_count);
+        (*m_job)(begin, end);
+    }
+}
+
+} // namespace Engine2D
@@ -0,0 +1,126 @@
+// 宽相检测后端性能对比
+// 用法: BroadphaseBench [物体数量] [帧数]
+
+#include "Engine2D/Physics/SpatialHash.h"
+#include "Engine2D/Physics/DynamicTree.h"
+#include "Engine2D/Physics/SweepAndPrune.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Engine2D;
+
+namespace {
+
+struct Body {
+    AABB aabb;
+    float speed;
+    int proxyId;
+};
+
+struct BenchResult {
+    double buildMs;
+    double averageFrameMs;
+    double maxFrameMs;
+    size_t averagePairs;
+};
+
+// 与FallingBlocks示例相同的场景：800x600区域内下落的30x30方块，外加地面和左右墙
+std::vector<Body> createRainScene(int count, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> xDist(30.0f, 770.0f);
+    std::uniform_real_distribution<float> yDist(-600.0f, 560.0f);
+    std::uniform_real_distribution<float> speedDist(20.0f, 200.0f);
+
+    std::vector<Body> bodies;
+    bodies.reserve(count + 3);
+
+    // 静态几何
+    bodies.push_back({ AABB(Vector2(0.0f, 560.0f), Vector2(800.0f, 600.0f)), 0.0f, -1 });
+    bodies.push_back({ AABB(Vector2(-10.0f, 0.0f), Vector2(10.0f, 600.0f)), 0.0f, -1 });
+    bodies.push_back({ AABB(Vector2(790.0f, 0.0f), Vector2(810.0f, 600.0f)), 0.0f, -1 });
+
+    for (int i = 0; i < count; ++i) {
+        const float x = xDist(rng);
+        const float y = yDist(rng);
+        bodies.push_back({ AABB(Vector2(x - 15.0f, y - 15.0f), Vector2(x + 15.0f, y + 15.0f)), speedDist(rng), -1 });
+    }
+    return bodies;
+}
+
+BenchResult runBench(Broadphase& broadphase, std::vector<Body> bodies, int frames) {
+    using Clock = std::chrono::high_resolution_clock;
+    const float deltaTime = 1.0f / 60.0f;
+
+    BenchResult result = {};
+
+    auto buildStart = Clock::now();
+    for (auto& body : bodies) {
+        body.proxyId = broadphase.createProxy(body.aabb, nullptr);
+    }
+    result.buildMs = std::chrono::duration<double, std::milli>(Clock::now() - buildStart).count();
+
+    std::vector<BroadphasePair> pairs;
+    double totalMs = 0.0;
+    size_t totalPairs = 0;
+
+    for (int frame = 0; frame < frames; ++frame) {
+        auto frameStart = Clock::now();
+
+        for (auto& body : bodies) {
+            if (body.speed == 0.0f) {
+                continue;
+            }
+
+            // 落到地面后回到顶部，模拟持续的方块雨
+            float dy = body.speed * deltaTime;
+            if (body.aabb.max.y + dy > 560.0f) {
+                dy = -600.0f;
+            }
+            body.aabb.min.y += dy;
+            body.aabb.max.y += dy;
+            broadphase.moveProxy(body.proxyId, body.aabb);
+        }
+        broadphase.computePairs(pairs);
+
+        const double frameMs = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+        totalMs += frameMs;
+        result.maxFrameMs = std::max(result.maxFrameMs, frameMs);
+        totalPairs += pairs.size();
+    }
+
+    result.averageFrameMs = totalMs / frames;
+    result.averagePairs = totalPairs / frames;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int count = argc > 1 ? std::atoi(argv[1]) : 5000;
+    const int frames = argc > 2 ? std::atoi(argv[2]) : 300;
+    const std::vector<Body> scene = createRainScene(count, 42);
+
+    struct Backend {
+        const char* name;
+        std::unique_ptr<Broadphase> broadphase;
+    };
+    Backend backends[] = {
+        { "SpatialHash", std::make_unique<SpatialHash>(64.0f) },
+        { "DynamicTree", std::make_unique<DynamicTree>(4.0f) },
+        { "SweepAndPrune", std::make_unique<SweepAndPrune>(0) },
+    };
+
+    std::printf("bodies=%d frames=%d\n", count, frames);
+    std::printf("%-14s %10s %12s %12s %10s\n", "backend", "build_ms", "avg_ms", "max_ms", "pairs");
+    for (auto& backend : backends) {
+        const BenchResult result = runBench(*backend.broadphase, scene, frames);
+        std::printf("%-14s %10.3f %12.4f %12.4f %10zu\n", backend.name,
+                    result.buildMs, result.averageFrameMs, result.maxFrameMs, result.averagePairs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,356 @@
+// 物理世界整体性能基准，不创建窗口
+// 用法: PhysicsBench [帧数] [线程数]
+// 每个场景输出一行JSON，便于脚本收集并跟踪性能回归
+
+#include "Engine2D/Core/GameObject.h"
+#include "Engine2D/Physics/Collider.h"
+#include "Engine2D/Physics/Rigidbody.h"
+#include "Engine2D/Physics/PhysicsWorld.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <vector>
+
+using namespace Engine2D;
+
+namespace {
+
+// 全局分配计数，只统计步进期间的分配
+std::atomic<size_t> g_allocationCount(0);
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+namespace {
+
+struct BenchResult {
+    int bodies;
+    int steps;
+    double totalMs;
+    double meanMs;
+    double p99Ms;
+    double maxMs;
+    size_t allocations;
+    double averageContacts;
+    double averageAwake;
+};
+
+/**
+ * @brief 基准场景，持有所有游戏对象与物理世界
+ */
+class BenchScene {
+public:
+    explicit BenchScene(int threadCount) {
+        m_world.initialize();
+        m_world.setThreadCount(threadCount);
+        // Profiler按调用记录每次耗时，会在步进中分配内存，基准只看物理本身
+        m_world.setProfilingEnabled(false);
+    }
+
+    ~BenchScene() {
+        m_world.shutdown();
+    }
+
+    PhysicsWorld& getWorld() { return m_world; }
+
+    // 添加静态矩形
+    void addStaticBox(const Vector2& position, float width, float height) {
+        GameObject* object = createObject(position);
+        m_world.addCollider(object->addComponent<BoxCollider>(width, height));
+    }
+
+    // 添加动态矩形
+    Rigidbody* addBox(const Vector2& position, float width, float height) {
+        GameObject* object = createObject(position);
+        Rigidbody* body = object->addComponent<Rigidbody>();
+        m_world.addRigidbody(body);
+        m_world.addCollider(object->addComponent<BoxCollider>(width, height));
+        return body;
+    }
+
+    // 添加动态圆
+    Rigidbody* addCircle(const Vector2& position, float radius) {
+        GameObject* object = createObject(position);
+        Rigidbody* body = object->addComponent<Rigidbody>();
+        m_world.addRigidbody(body);
+        m_world.addCollider(object->addComponent<CircleCollider>(radius));
+        return body;
+    }
+
+private:
+    GameObject* createObject(const Vector2& position) {
+        m_objects.push_back(std::make_unique<GameObject>("Body"));
+        GameObject* object = m_objects.back().get();
+        object->initialize();
+        object->getTransform()->setPosition(position);
+        return object;
+    }
+
+    PhysicsWorld m_world;
+    std::vector<std::unique_ptr<GameObject>> m_objects;
+};
+
+// 并排的方块金字塔，测试堆叠求解与休眠
+void buildPyramids(BenchScene& scene) {
+    const int pyramidCount = 4;
+    const int baseCount = 20;
+    const float size = 30.0f;
+    const float groundY = 600.0f;
+
+    scene.getWorld().setGravity(Vector2(0.0f, 980.0f));
+    scene.addStaticBox(Vector2(1400.0f, groundY + 20.0f), 2800.0f, 40.0f);
+    for (int p = 0; p < pyramidCount; ++p) {
+        const float originX = 100.0f + p * (baseCount + 3) * size;
+        for (int row = 0; row < baseCount; ++row) {
+            for (int i = 0; i < baseCount - row; ++i) {
+                const float x = originX + (i + row * 0.5f) * size;
+                const float y = groundY - size * 0.5f - row * size;
+                scene.addBox(Vector2(x, y), size, size);
+            }
+        }
+    }
+}
+
+// 与FallingBlocks示例相同的30x30方块雨，1万个物体落到宽地面上
+void buildRain(BenchScene& scene) {
+    const int columns = 100;
+    const int rows = 100;
+    const float spacing = 40.0f;
+    const float groundY = 600.0f;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> jitter(-4.0f, 4.0f);
+
+    scene.getWorld().setGravity(Vector2(0.0f, 980.0f));
+    scene.addStaticBox(Vector2(columns * spacing * 0.5f, groundY + 20.0f), columns * spacing + 200.0f, 40.0f);
+    scene.addStaticBox(Vector2(-110.0f, groundY - 2000.0f), 20.0f, 4000.0f);
+    scene.addStaticBox(Vector2(columns * spacing + 110.0f, groundY - 2000.0f), 20.0f, 4000.0f);
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            const Vector2 position(column * spacing + spacing * 0.5f + jitter(rng),
+                                   groundY - 100.0f - row * spacing + jitter(rng));
+            scene.addBox(position, 30.0f, 30.0f);
+        }
+    }
+}
+
+// 无重力的封闭区域内随机散布、随机速度的圆，测试大量持续的圆-圆接触
+void buildScatter(BenchScene& scene) {
+    const int count = 5000;
+    const float width = 3000.0f;
+    const float height = 2000.0f;
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> xDist(20.0f, width - 20.0f);
+    std::uniform_real_distribution<float> yDist(20.0f, height - 20.0f);
+    std::uniform_real_distribution<float> radiusDist(4.0f, 12.0f);
+    std::uniform_real_distribution<float> speedDist(-150.0f, 150.0f);
+
+    scene.getWorld().setGravity(Vector2(0.0f, 0.0f));
+    scene.addStaticBox(Vector2(width * 0.5f, -10.0f), width, 20.0f);
+    scene.addStaticBox(Vector2(width * 0.5f, height + 10.0f), width, 20.0f);
+    scene.addStaticBox(Vector2(-10.0f, height * 0.5f), 20.0f, height);
+    scene.addStaticBox(Vector2(width + 10.0f, height * 0.5f), 20.0f, height);
+    for (int i = 0; i < count; ++i) {
+        Rigidbody* body = scene.addCircle(Vector2(xDist(rng), yDist(rng)), radiusDist(rng));
+        body->setVelocity(Vector2(speedDist(rng), speedDist(rng)));
+    }
+}
+
+// 100列×20层对齐的方块堆叠在地面上，共2000个刚体，用于快照保存与恢复的计时
+void buildSnapshotScene(BenchScene& scene) {
+    const int columns = 100;
+    const int rows = 20;
+    const float spacing = 40.0f;
+    const float size = 30.0f;
+    const float groundY = 600.0f;
+
+    scene.getWorld().setGravity(Vector2(0.0f, 980.0f));
+    scene.addStaticBox(Vector2(columns * spacing * 0.5f, groundY + 20.0f), columns * spacing + 400.0f, 40.0f);
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            scene.addBox(Vector2(column * spacing + spacing * 0.5f, groundY - size * 0.5f - row * size), size, size);
+        }
+    }
+}
+
+struct SnapshotResult {
+    int bodies;
+    int rounds;
+    size_t bytes;
+    double saveMeanMs;
+    double saveMaxMs;
+    double restoreMeanMs;
+    double restoreMaxMs;
+    size_t allocations;
+};
+
+// 每轮先保存快照，再步进一帧让状态偏离，然后恢复；快照对象复用，稳定后不应再分配
+SnapshotResult runSnapshot(int rounds, int threadCount) {
+    using Clock = std::chrono::steady_clock;
+    const float deltaTime = 1.0f / 60.0f;
+
+    BenchScene scene(threadCount);
+    buildSnapshotScene(scene);
+    PhysicsWorld& world = scene.getWorld();
+    auto step = [&]() {
+        world.update(deltaTime);
+        world.syncTransforms();
+        Transform::clearMovedTransforms();
+    };
+
+    // 只步进一秒：堆叠已建立完整的接触缓存，但刚体还未休眠，每次恢复都要移动全部宽相代理
+    for (int frame = 0; frame < 60; ++frame) {
+        step();
+    }
+
+    PhysicsSnapshot snapshot;
+    world.saveState(snapshot);
+    step();
+    world.restoreState(snapshot);
+
+    SnapshotResult result = {};
+    const size_t allocationsBefore = g_allocationCount.load();
+    for (int round = 0; round < rounds; ++round) {
+        Clock::time_point start = Clock::now();
+        world.saveState(snapshot);
+        const double saveMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        step();
+
+        start = Clock::now();
+        world.restoreState(snapshot);
+        Transform::clearMovedTransforms();
+        const double restoreMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        result.saveMeanMs += saveMs;
+        result.saveMaxMs = std::max(result.saveMaxMs, saveMs);
+        result.restoreMeanMs += restoreMs;
+        result.restoreMaxMs = std::max(result.restoreMaxMs, restoreMs);
+    }
+    // 计数中包含每轮步进的分配，步进本身在稳态下不分配
+    result.allocations = g_allocationCount.load() - allocationsBefore;
+
+    result.bodies = world.getStats().bodyCount;
+    result.rounds = rounds;
+    result.bytes = snapshot.getByteSize();
+    result.saveMeanMs /= std::max(rounds, 1);
+    result.restoreMeanMs /= std::max(rounds, 1);
+    return result;
+}
+
+BenchResult runScene(void (*build)(BenchScene&), int frames, int threadCount) {
+    using Clock = std::chrono::steady_clock;
+    const float deltaTime = 1.0f / 60.0f;
+
+    BenchScene scene(threadCount);
+    build(scene);
+    PhysicsWorld& world = scene.getWorld();
+
+    // 先步进几帧让各缓冲区达到稳定容量，分配计数只反映稳态
+    const int warmupFrames = std::min(10, frames);
+    for (int frame = 0; frame < warmupFrames; ++frame) {
+        world.update(deltaTime);
+        world.syncTransforms();
+        Transform::clearMovedTransforms();
+    }
+
+    std::vector<double> stepTimes;
+    stepTimes.reserve(frames);
+    double contacts = 0.0;
+    double awake = 0.0;
+
+    const size_t allocationsBefore = g_allocationCount.load();
+    for (int frame = 0; frame < frames; ++frame) {
+        const Clock::time_point start = Clock::now();
+        world.update(deltaTime);
+        world.syncTransforms();
+        Transform::clearMovedTransforms();
+        stepTimes.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+        contacts += world.getStats().contactCount;
+        awake += world.getStats().awakeBodyCount;
+    }
+    const size_t allocations = g_allocationCount.load() - allocationsBefore;
+
+    BenchResult result = {};
+    result.bodies = world.getStats().bodyCount;
+    result.steps = frames;
+    for (double time : stepTimes) {
+        result.totalMs += time;
+    }
+    result.meanMs = result.totalMs / std::max(frames, 1);
+    result.allocations = allocations;
+    result.averageContacts = contacts / std::max(frames, 1);
+    result.averageAwake = awake / std::max(frames, 1);
+
+    if (!stepTimes.empty()) {
+        std::sort(stepTimes.begin(), stepTimes.end());
+        const size_t p99Index = static_cast<size_t>(std::ceil(stepTimes.size() * 0.99)) - 1;
+        result.p99Ms = stepTimes[std::min(p99Index, stepTimes.size() - 1)];
+        result.maxMs = stepTimes.back();
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : 600;
+    const int threadCount = argc > 2 ? std::max(0, std::atoi(argv[2])) : 0;
+
+    struct SceneEntry {
+        const char* name;
+        void (*build)(BenchScene&);
+    };
+    const SceneEntry scenes[] = {
+        { "pyramids", buildPyramids },
+        { "rain", buildRain },
+        { "scatter", buildScatter },
+    };
+
+    for (const SceneEntry& entry : scenes) {
+        const BenchResult result = runScene(entry.build, frames, threadCount);
+        const double stepsPerSecond = result.totalMs > 0.0 ? result.steps * 1000.0 / result.totalMs : 0.0;
+        std::printf("{\"scene\":\"%s\",\"bodies\":%d,\"threads\":%d,\"steps\":%d,\"steps_per_sec\":%.2f,"
+                    "\"mean_ms\":%.4f,\"p99_ms\":%.4f,\"max_ms\":%.4f,\"allocations\":%zu,"
+                    "\"allocations_per_step\":%.2f,\"avg_contacts\":%.1f,\"avg_awake\":%.1f}\n",
+                    entry.name, result.bodies, threadCount, result.steps, stepsPerSecond,
+                    result.meanMs, result.p99Ms, result.maxMs, result.allocations,
+                    static_cast<double>(result.allocations) / result.steps,
+                    result.averageContacts, result.averageAwake);
+        std::fflush(stdout);
+    }
+
+    // 回滚的开销：目标是2000个刚体的保存与恢复都在1毫秒以内
+    const SnapshotResult snapshot = runSnapshot(std::min(frames, 200), threadCount);
+    std::printf("{\"scene\":\"snapshot\",\"bodies\":%d,\"threads\":%d,\"rounds\":%d,\"bytes\":%zu,"
+                "\"save_mean_ms\":%.4f,\"save_max_ms\":%.4f,\"restore_mean_ms\":%.4f,\"restore_max_ms\":%.4f,"
+                "\"allocations\":%zu}\n",
+                snapshot.bodies, threadCount, snapshot.rounds, snapshot.bytes, snapshot.saveMeanMs,
+                snapshot.saveMaxMs, snapshot.restoreMeanMs, snapshot.restoreMaxMs, snapshot.allocations);
+    std::fflush(stdout);
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+// AtlasPacker装箱测试：插入的矩形都在区域内且互不重叠
+
+#include "Engine2D/Graphics/TextureAtlas.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace Engine2D;
+
+namespace {
+
+// 逐像素记录占用情况，发现重叠或越界时报告失败
+class Occupancy {
+public:
+    Occupancy(int width, int height)
+        : m_width(width)
+        , m_height(height)
+        , m_cells(static_cast<size_t>(width) * height, 0) {
+    }
+
+    void mark(int x, int y, int width, int height) {
+        ASSERT_GE(x, 0);
+        ASSERT_GE(y, 0);
+        ASSERT_LE(x + width, m_width);
+        ASSERT_LE(y + height, m_height);
+        for (int row = y; row < y + height; ++row) {
+            for (int column = x; column < x + width; ++column) {
+                uint8_t& cell = m_cells[row * m_width + column];
+                ASSERT_EQ(cell, 0) << "像素 (" << column << ", " << row << ") 被重复占用";
+                cell = 1;
+            }
+        }
+    }
+
+private:
+    int m_width;
+    int m_height;
+    std::vector<uint8_t> m_cells;
+};
+
+} // namespace
+
+TEST(AtlasPackerTest, RandomInsertsNeverOverlap) {
+    const int pageSize = 512;
+    std::mt19937 random(31337);
+    std::uniform_int_distribution<int> size(1, 48);
+
+    for (int round = 0; round < 10; ++round) {
+        AtlasPacker packer(pageSize, pageSize);
+        Occupancy occupancy(pageSize, pageSize);
+        int inserted = 0;
+        int failures = 0;
+        // 一直插入到连续失败多次，确保覆盖页面接近占满时的情况
+        while (failures < 50) {
+            const int width = size(random);
+            const int height = size(random);
+            int x = -1;
+            int y = -1;
+            if (!packer.insert(width, height, x, y)) {
+                ++failures;
+                continue;
+            }
+            ++inserted;
+            occupancy.mark(x, y, width, height);
+            if (HasFatalFailure()) {
+                return;
+            }
+        }
+        EXPECT_GT(inserted, 0);
+    }
+}
+
+TEST(AtlasPackerTest, ExactFitThenFull) {
+    AtlasPacker packer(128, 128);
+    Occupancy occupancy(128, 128);
+    for (int i = 0; i < 4; ++i) {
+        int x = -1;
+        int y = -1;
+        ASSERT_TRUE(packer.insert(64, 64, x, y)) << "第 " << i << " 块";
+        occupancy.mark(x, y, 64, 64);
+    }
+
+    int x = 0;
+    int y = 0;
+    EXPECT_FALSE(packer.insert(1, 1, x, y));
+}
+
+TEST(AtlasPackerTest, UniformTilesFillWholePage) {
+    AtlasPacker packer(256, 256);
+    Occupancy occupancy(256, 256);
+    for (int i = 0; i < 256; ++i) {
+        int x = -1;
+        int y = -1;
+        ASSERT_TRUE(packer.insert(16, 16, x, y)) << "第 " << i << " 块";
+        occupancy.mark(x, y, 16, 16);
+    }
+
+    int x = 0;
+    int y = 0;
+    EXPECT_FALSE(packer.insert(16, 16, x, y));
+}
+
+TEST(AtlasPackerTest, RejectsOversizedAndEmpty) {
+    AtlasPacker packer(64, 32);
+    int x = 0;
+    int y = 0;
+    EXPECT_FALSE(packer.insert(65, 1, x, y));
+    EXPECT_FALSE(packer.insert(1, 33, x, y));
+    EXPECT_FALSE(packer.insert(0, 10, x, y));
+    EXPECT_FALSE(packer.insert(10, 0, x, y));
+    EXPECT_FALSE(packer.insert(-4, 4, x, y));
+
+    // 失败的插入不应占用空间
+    EXPECT_TRUE(packer.insert(64, 32, x, y));
+    EXPECT_EQ(x, 0);
+    EXPECT_EQ(y, 0);
+}
+
+TEST(AtlasPackerTest, FillAndReset) {
+    AtlasPacker packer(64, 64);
+    int x = 0;
+    int y = 0;
+    packer.fill();
+    EXPECT_FALSE(packer.insert(1, 1, x, y));
+
+    packer.reset(32, 32);
+    EXPECT_FALSE(packer.insert(33, 1, x, y));
+    EXPECT_TRUE(packer.insert(32, 32, x, y));
+    EXPECT_EQ(x, 0);
+    EXPECT_EQ(y, 0);
+}
@@ -0,0 +1,308 @@
+// 宽相后端测试：随机插入、移动、删除之后，碰撞对、区域查询和射线遍历与O(n²)暴力检查一致
+
+#include "Engine2D/Physics/Collider.h"
+#include "Engine2D/Physics/DynamicTree.h"
+#include "Engine2D/Physics/SpatialHash.h"
+#include "Engine2D/Physics/SweepAndPrune.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace Engine2D;
+
+namespace {
+
+// 射线段与包围盒的slab测试，与后端无关的参考实现
+bool segmentHitsAABB(const Vector2& origin, const Vector2& direction, float maxDistance, const AABB& aabb) {
+    float tMin = 0.0f;
+    float tMax = maxDistance;
+    const float origins[2] = { origin.x, origin.y };
+    const float directions[2] = { direction.x, direction.y };
+    const float mins[2] = { aabb.min.x, aabb.min.y };
+    const float maxs[2] = { aabb.max.x, aabb.max.y };
+    for (int axis = 0; axis < 2; ++axis) {
+        if (std::fabs(directions[axis]) < 1e-8f) {
+            if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) {
+                return false;
+            }
+            continue;
+        }
+        float t1 = (mins[axis] - origins[axis]) / directions[axis];
+        float t2 = (maxs[axis] - origins[axis]) / directions[axis];
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 对一个宽相后端执行随机的插入、移动、删除序列，并定期与暴力检查比较。
+// 每个代理关联一个独立的碰撞体，结果通过碰撞体指针映射回代理；比较以后端登记的包围盒为准，
+// 动态树登记的是扩展后的包围盒，此外还检查登记的包围盒包含实际包围盒
+class BroadphaseChecker {
+public:
+    BroadphaseChecker(Broadphase& broadphase, unsigned seed)
+        : m_broadphase(broadphase)
+        , m_random(seed) {
+    }
+
+    // 执行operations次随机操作，每interval次检查一遍
+    void run(int operations, int interval) {
+        std::uniform_int_distribution<int> choice(0, 9);
+        for (int i = 0; i < operations; ++i) {
+            const int action = choice(m_random);
+            if (m_live.size() < 8 || action < 4) {
+                insert();
+            } else if (action < 8) {
+                move();
+            } else {
+                remove();
+            }
+
+            if ((i + 1) % interval == 0) {
+                SCOPED_TRACE(testing::Message() << "第 " << i + 1 << " 次操作之后，代理数 " << m_live.size());
+                check();
+                if (testing::Test::HasFatalFailure()) {
+                    return;
+                }
+            }
+        }
+    }
+
+    // 清空后端之后不应再报告任何结果
+    void checkCleared() {
+        m_broadphase.clear();
+        m_live.clear();
+        EXPECT_EQ(m_broadphase.getProxyCount(), 0);
+        std::vector<BroadphasePair> pairs;
+        m_broadphase.computePairs(pairs);
+        EXPECT_TRUE(pairs.empty());
+        std::vector<Collider*> results;
+        m_broadphase.query(AABB(Vector2(-2000.0f, -2000.0f), Vector2(2000.0f, 2000.0f)), results);
+        EXPECT_TRUE(results.empty());
+    }
+
+private:
+    struct Entry {
+        int proxyId;
+        AABB aabb;
+    };
+
+    // 大多数是小物体，偶尔有跨越很多网格单元的大物体
+    AABB randomAABB() {
+        std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+        std::uniform_real_distribution<float> smallSize(2.0f, 60.0f);
+        std::uniform_real_distribution<float> largeSize(100.0f, 600.0f);
+        std::bernoulli_distribution large(0.05);
+        const Vector2 position(coordinate(m_random), coordinate(m_random));
+        const Vector2 size = large(m_random) ? Vector2(largeSize(m_random), largeSize(m_random))
+                                             : Vector2(smallSize(m_random), smallSize(m_random));
+        return AABB(position, position + size);
+    }
+
+    void insert() {
+        m_colliders.push_back(std::make_unique<BoxCollider>(1.0f, 1.0f));
+        Collider* collider = m_colliders.back().get();
+        Entry entry;
+        entry.aabb = randomAABB();
+        entry.proxyId = m_broadphase.createProxy(entry.aabb, collider);
+        m_live[collider] = entry;
+    }
+
+    // 多数移动是连贯的小位移，少数是传送
+    void move() {
+        auto it = randomLive();
+        Entry& entry = it->second;
+        std::bernoulli_distribution teleport(0.2);
+        if (teleport(m_random)) {
+            entry.aabb = randomAABB();
+        } else {
+            std::uniform_real_distribution<float> offset(-12.0f, 12.0f);
+            const Vector2 delta(offset(m_random), offset(m_random));
+            entry.aabb = AABB(entry.aabb.min + delta, entry.aabb.max + delta);
+        }
+        m_broadphase.moveProxy(entry.proxyId, entry.aabb);
+    }
+
+    void remove() {
+        auto it = randomLive();
+        m_broadphase.destroyProxy(it->second.proxyId);
+        m_live.erase(it);
+    }
+
+    std::unordered_map<Collider*, Entry>::iterator randomLive() {
+        std::uniform_int_distribution<size_t> index(0, m_live.size() - 1);
+        auto it = m_live.begin();
+        std::advance(it, index(m_random));
+        return it;
+    }
+
+    void check() {
+        ASSERT_EQ(m_broadphase.getProxyCount(), static_cast<int>(m_live.size()));
+
+        // 登记的包围盒与碰撞体的对应关系
+        std::vector<std::pair<Collider*, AABB>> registered;
+        for (const auto& item : m_live) {
+            const Entry& entry = item.second;
+            ASSERT_EQ(m_broadphase.getCollider(entry.proxyId), item.first);
+            const AABB& aabb = m_broadphase.getAABB(entry.proxyId);
+            ASSERT_TRUE(aabb.contains(entry.aabb)) << "代理 " << entry.proxyId;
+            registered.emplace_back(item.first, aabb);
+        }
+
+        // 查询先于计算碰撞对，覆盖移动之后尚未整理结构时的查询路径（排序扫描在computePairs中重新排序端点）
+        for (int i = 0; i < 20; ++i) {
+            checkQuery(registered, randomAABB());
+            if (testing::Test::HasFatalFailure()) {
+                return;
+            }
+        }
+
+        std::uniform_real_distribution<float> coordinate(-1100.0f, 1100.0f);
+        std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+        std::uniform_real_distribution<float> length(10.0f, 1500.0f);
+        for (int i = 0; i < 20; ++i) {
+            const float direction = angle(m_random);
+            checkRaycast(registered, Vector2(coordinate(m_random), coordinate(m_random)),
+                         Vector2(std::cos(direction), std::sin(direction)), length(m_random));
+            if (testing::Test::HasFatalFailure()) {
+                return;
+            }
+        }
+        // 轴对齐的射线走方向分量为0的分支
+        checkRaycast(registered, Vector2(coordinate(m_random), coordinate(m_random)), Vector2(1.0f, 0.0f), 1500.0f);
+        checkRaycast(registered, Vector2(coordinate(m_random), coordinate(m_random)), Vector2(0.0f, -1.0f), 1500.0f);
+        if (testing::Test::HasFatalFailure()) {
+            return;
+        }
+
+        checkPairs(registered);
+    }
+
+    // 碰撞对恰好是登记包围盒两两重叠的集合，且没有重复
+    void checkPairs(const std::vector<std::pair<Collider*, AABB>>& registered) {
+        std::vector<std::pair<Collider*, Collider*>> expected;
+        for (size_t i = 0; i < registered.size(); ++i) {
+            for (size_t j = i + 1; j < registered.size(); ++j) {
+                if (registered[i].second.overlaps(registered[j].second)) {
+                    expected.emplace_back(std::min(registered[i].first, registered[j].first),
+                                          std::max(registered[i].first, registered[j].first));
+                }
+            }
+        }
+
+        std::vector<BroadphasePair> pairs;
+        m_broadphase.computePairs(pairs);
+        std::vector<std::pair<Collider*, Collider*>> actual;
+        for (const BroadphasePair& pair : pairs) {
+            ASSERT_NE(pair.colliderA, pair.colliderB);
+            ASSERT_EQ(pair.subShape, -1);
+            actual.emplace_back(std::min(pair.colliderA, pair.colliderB), std::max(pair.colliderA, pair.colliderB));
+        }
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        ASSERT_TRUE(std::adjacent_find(actual.begin(), actual.end()) == actual.end()) << "碰撞对重复";
+        ASSERT_EQ(actual.size(), expected.size());
+        ASSERT_TRUE(actual == expected);
+    }
+
+    // 区域查询恰好返回登记包围盒与区域重叠的碰撞体，且没有重复
+    void checkQuery(const std::vector<std::pair<Collider*, AABB>>& registered, const AABB& area) {
+        std::vector<Collider*> expected;
+        for (const auto& item : registered) {
+            if (item.second.overlaps(area)) {
+                expected.push_back(item.first);
+            }
+        }
+
+        std::vector<Collider*> actual;
+        m_broadphase.query(area, actual);
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        ASSERT_TRUE(std::adjacent_find(actual.begin(), actual.end()) == actual.end()) << "查询结果重复";
+        ASSERT_TRUE(actual == expected);
+    }
+
+    // 射线遍历必须访问所有被射线段穿过的登记包围盒，每个最多一次；
+    // 允许多报，但多报的碰撞体至少要与射线段的包围盒重叠
+    void checkRaycast(const std::vector<std::pair<Collider*, AABB>>& registered, const Vector2& origin,
+                      const Vector2& direction, float maxDistance) {
+        std::vector<Collider*> visited;
+        m_broadphase.raycast(origin, direction, maxDistance, [&](Collider* collider) {
+            visited.push_back(collider);
+            return maxDistance;
+        });
+        std::sort(visited.begin(), visited.end());
+        ASSERT_TRUE(std::adjacent_find(visited.begin(), visited.end()) == visited.end()) << "射线遍历重复";
+
+        const Vector2 end = origin + direction * maxDistance;
+        const AABB segment(Vector2(std::min(origin.x, end.x), std::min(origin.y, end.y)),
+                           Vector2(std::max(origin.x, end.x), std::max(origin.y, end.y)));
+        for (const auto& item : registered) {
+            const bool found = std::binary_search(visited.begin(), visited.end(), item.first);
+            if (segmentHitsAABB(origin, direction, maxDistance, item.second)) {
+                ASSERT_TRUE(found) << "漏掉了被射线穿过的代理 " << m_live[item.first].proxyId;
+            } else if (found) {
+                ASSERT_TRUE(item.second.overlaps(segment)) << "访问了远离射线的代理 " << m_live[item.first].proxyId;
+            }
+        }
+    }
+
+    Broadphase& m_broadphase;
+    std::mt19937 m_random;
+    std::vector<std::unique_ptr<BoxCollider>> m_colliders;  // 只作为代理的标识，删除代理后也保留，指针不会被复用
+    std::unordered_map<Collider*, Entry> m_live;             // 当前存在的代理
+};
+
+} // namespace
+
+TEST(BroadphaseTest, SpatialHashMatchesBruteForce) {
+    SpatialHash hash(64.0f);
+    BroadphaseChecker checker(hash, 101);
+    checker.run(2000, 100);
+    checker.checkCleared();
+}
+
+TEST(BroadphaseTest, SpatialHashSmallCellsMatchBruteForce) {
+    // 网格远小于物体时每个代理跨越大量单元，重点检查跨单元去重
+    SpatialHash hash(8.0f);
+    BroadphaseChecker checker(hash, 102);
+    checker.run(1000, 50);
+}
+
+TEST(BroadphaseTest, DynamicTreeMatchesBruteForce) {
+    // 默认扩展边距下小位移不会重新插入，碰撞对按扩展后的包围盒比较
+    DynamicTree tree;
+    BroadphaseChecker checker(tree, 201);
+    checker.run(2000, 100);
+    checker.checkCleared();
+}
+
+TEST(BroadphaseTest, DynamicTreeWithoutMarginMatchesBruteForce) {
+    // 边距为0时每次移动都重新插入叶节点，重点检查删除与平衡
+    DynamicTree tree(0.0f);
+    BroadphaseChecker checker(tree, 202);
+    checker.run(2000, 100);
+}
+
+TEST(BroadphaseTest, SweepAndPruneMatchesBruteForce) {
+    // 两个扫描轴各跑一遍；插入排序依赖端点几乎有序，传送会打乱顺序
+    for (int axis = 0; axis < 2; ++axis) {
+        SCOPED_TRACE(testing::Message() << "扫描轴 " << axis);
+        SweepAndPrune sweep(axis);
+        BroadphaseChecker checker(sweep, 301 + axis);
+        checker.run(2000, 100);
+        checker.checkCleared();
+    }
+}
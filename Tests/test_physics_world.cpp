@@ -0,0 +1,421 @@
+// PhysicsWorld测试：事件回调、确定性、状态回滚、层碰撞剔除和批量射线检测
+
+#include "Engine2D/Core/GameObject.h"
+#include "Engine2D/Core/Transform.h"
+#include "Engine2D/Physics/Collider.h"
+#include "Engine2D/Physics/Rigidbody.h"
+#include "Engine2D/Physics/PhysicsWorld.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Engine2D;
+
+namespace {
+
+const float TIME_STEP = 1.0f / 60.0f;
+
+// 持有一个独立的物理世界和场景中的游戏对象，碰撞体和刚体显式登记到这个世界
+class PhysicsScene {
+public:
+    PhysicsScene() {
+        m_world.initialize();
+        m_world.setGravity(Vector2(0.0f, 980.0f));
+    }
+
+    ~PhysicsScene() {
+        // 先解除世界中的句柄，再销毁对象
+        m_world.shutdown();
+        m_objects.clear();
+    }
+
+    PhysicsWorld& getWorld() {
+        return m_world;
+    }
+
+    const std::vector<Rigidbody*>& getBodies() const {
+        return m_bodies;
+    }
+
+    // 创建静态矩形
+    Collider* createStaticBox(const Vector2& position, float width, float height) {
+        GameObject* object = createObject(position, 0.0f);
+        Collider* collider = object->addComponent<BoxCollider>(width, height);
+        m_world.addCollider(collider);
+        return collider;
+    }
+
+    // 创建动态矩形
+    Rigidbody* createDynamicBox(const Vector2& position, float size, float rotation = 0.0f) {
+        GameObject* object = createObject(position, rotation);
+        Rigidbody* body = object->addComponent<Rigidbody>();
+        m_world.addRigidbody(body);
+        m_world.addCollider(object->addComponent<BoxCollider>(size, size));
+        m_bodies.push_back(body);
+        return body;
+    }
+
+    // 地面上随机堆放的一堆矩形，同样的种子总是生成同样的场景。maxRotation为初始旋转的最大幅度，
+    // reverseAllocation为true时按相反顺序创建组件，碰撞体地址的先后与登记顺序相反
+    void createPile(int count, unsigned seed, float maxRotation, bool reverseAllocation) {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> jitter(-4.0f, 4.0f);
+        std::uniform_real_distribution<float> angle(-maxRotation, maxRotation);
+        createStaticBox(Vector2(0.0f, 400.0f), 2400.0f, 40.0f);
+
+        std::vector<GameObject*> objects;
+        for (int i = 0; i < count; ++i) {
+            const Vector2 position(-600.0f + (i % 30) * 40.0f + jitter(random), 340.0f - (i / 30) * 36.0f);
+            objects.push_back(createObject(position, angle(random)));
+        }
+        for (int k = 0; k < count; ++k) {
+            GameObject* object = objects[reverseAllocation ? count - 1 - k : k];
+            object->addComponent<Rigidbody>();
+            object->addComponent<BoxCollider>(30.0f, 30.0f);
+        }
+        for (GameObject* object : objects) {
+            Rigidbody* body = object->getComponent<Rigidbody>();
+            m_world.addRigidbody(body);
+            m_world.addCollider(object->getComponent<BoxCollider>());
+            m_bodies.push_back(body);
+        }
+    }
+
+    void step(int frames) {
+        for (int i = 0; i < frames; ++i) {
+            m_world.update(TIME_STEP);
+            m_world.syncTransforms();
+            Transform::clearMovedTransforms();
+        }
+    }
+
+private:
+    GameObject* createObject(const Vector2& position, float rotation) {
+        m_objects.push_back(std::make_unique<GameObject>("Object"));
+        GameObject* object = m_objects.back().get();
+        object->initialize();
+        object->getTransform()->setPosition(position);
+        object->getTransform()->setRotation(rotation);
+        return object;
+    }
+
+    PhysicsWorld m_world;
+    std::vector<std::unique_ptr<GameObject>> m_objects;
+    std::vector<Rigidbody*> m_bodies;
+};
+
+// 逐个比较两个场景中刚体的位置、旋转和速度，要求完全相等
+void expectSameBodies(const PhysicsScene& expected, const PhysicsScene& actual) {
+    ASSERT_EQ(expected.getBodies().size(), actual.getBodies().size());
+    for (size_t i = 0; i < expected.getBodies().size(); ++i) {
+        const Rigidbody* a = expected.getBodies()[i];
+        const Rigidbody* b = actual.getBodies()[i];
+        ASSERT_EQ(a->getTransform()->getPosition().x, b->getTransform()->getPosition().x) << "刚体 " << i;
+        ASSERT_EQ(a->getTransform()->getPosition().y, b->getTransform()->getPosition().y) << "刚体 " << i;
+        ASSERT_EQ(a->getTransform()->getRotation(), b->getTransform()->getRotation()) << "刚体 " << i;
+        ASSERT_EQ(a->getVelocity().x, b->getVelocity().x) << "刚体 " << i;
+        ASSERT_EQ(a->getVelocity().y, b->getVelocity().y) << "刚体 " << i;
+        ASSERT_EQ(a->getAngularVelocity(), b->getAngularVelocity()) << "刚体 " << i;
+        ASSERT_EQ(a->isAsleep(), b->isAsleep()) << "刚体 " << i;
+    }
+}
+
+// 比较两个快照的全部内容，包括休眠链表和热启动缓存中的累积冲量
+void expectSameSnapshot(const PhysicsSnapshot& expected, const PhysicsSnapshot& actual) {
+    ASSERT_EQ(expected.rigidbodies, actual.rigidbodies);
+    const size_t count = expected.rigidbodies.size();
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(expected.positions[i].x, actual.positions[i].x) << "刚体 " << i;
+        ASSERT_EQ(expected.positions[i].y, actual.positions[i].y) << "刚体 " << i;
+        ASSERT_EQ(expected.rotations[i], actual.rotations[i]) << "刚体 " << i;
+        ASSERT_EQ(expected.velocities[i].x, actual.velocities[i].x) << "刚体 " << i;
+        ASSERT_EQ(expected.velocities[i].y, actual.velocities[i].y) << "刚体 " << i;
+        ASSERT_EQ(expected.angularVelocities[i], actual.angularVelocities[i]) << "刚体 " << i;
+        ASSERT_EQ(expected.sleepTimers[i], actual.sleepTimers[i]) << "刚体 " << i;
+        ASSERT_EQ(expected.sleepLinks[i], actual.sleepLinks[i]) << "刚体 " << i;
+        ASSERT_EQ(expected.asleep[i], actual.asleep[i]) << "刚体 " << i;
+    }
+
+    ASSERT_EQ(expected.manifolds.size(), actual.manifolds.size());
+    for (size_t i = 0; i < expected.manifolds.size(); ++i) {
+        const ContactManifold& a = expected.manifolds[i];
+        const ContactManifold& b = actual.manifolds[i];
+        ASSERT_EQ(a.colliderA, b.colliderA) << "流形 " << i;
+        ASSERT_EQ(a.colliderB, b.colliderB) << "流形 " << i;
+        ASSERT_EQ(a.subShape, b.subShape) << "流形 " << i;
+        ASSERT_EQ(a.pointCount, b.pointCount) << "流形 " << i;
+        for (int k = 0; k < a.pointCount; ++k) {
+            ASSERT_EQ(a.points[k].id, b.points[k].id) << "流形 " << i;
+            ASSERT_EQ(a.points[k].normalImpulse, b.points[k].normalImpulse) << "流形 " << i;
+            ASSERT_EQ(a.points[k].tangentImpulse, b.points[k].tangentImpulse) << "流形 " << i;
+        }
+    }
+
+    ASSERT_EQ(expected.contactPairs.size(), actual.contactPairs.size());
+    for (size_t i = 0; i < expected.contactPairs.size(); ++i) {
+        ASSERT_EQ(expected.contactPairs[i].colliderA, actual.contactPairs[i].colliderA) << "碰撞对 " << i;
+        ASSERT_EQ(expected.contactPairs[i].colliderB, actual.contactPairs[i].colliderB) << "碰撞对 " << i;
+    }
+    ASSERT_EQ(expected.contactTriggers, actual.contactTriggers);
+}
+
+} // namespace
+
+TEST(PhysicsWorldTest, CallbacksCanSpawnAndDestroyBodies) {
+    PhysicsScene scene;
+    scene.createStaticBox(Vector2(0.0f, 100.0f), 2000.0f, 20.0f);
+
+    // 落地的刚体中一部分启用CCD，回调中移除时会在m_ccdBodies中留下下标
+    std::vector<Rigidbody*> bodies;
+    for (int i = 0; i < 40; ++i) {
+        Rigidbody* body = scene.createDynamicBox(Vector2(-800.0f + i * 40.0f, 60.0f), 30.0f);
+        body->setUseCCD(i % 2 == 0);
+        bodies.push_back(body);
+    }
+
+    int spawned = 0;
+    int destroyed = 0;
+    scene.getWorld().setCollisionCallback([&](const CollisionInfo&) {
+        // 每个接触生成一个新刚体，同时移除一个已有刚体
+        if (spawned < 200) {
+            scene.createDynamicBox(Vector2(-900.0f + spawned * 9.0f, -200.0f), 8.0f)->setUseCCD(true);
+            ++spawned;
+        }
+        if (!bodies.empty()) {
+            Rigidbody* body = bodies.back();
+            bodies.pop_back();
+            body->getGameObject()->removeComponent<Rigidbody>();
+            ++destroyed;
+        }
+    });
+
+    scene.step(120);
+
+    EXPECT_GT(spawned, 0);
+    EXPECT_GT(destroyed, 0);
+    EXPECT_EQ(scene.getWorld().getStats().bodyCount, 40 + spawned - destroyed);
+}
+
+TEST(PhysicsWorldTest, EventsSeeFinishedStep) {
+    PhysicsScene scene;
+    scene.createStaticBox(Vector2(0.0f, 100.0f), 400.0f, 20.0f);
+    scene.createDynamicBox(Vector2(0.0f, 74.0f), 30.0f);
+
+    // 事件回调在整步完成后调用，此时本步的统计已经写好
+    PhysicsWorld& world = scene.getWorld();
+    int calls = 0;
+    world.setContactEventCallback([&](const ContactEvents& events) {
+        if (events.collisionEnter.empty() && events.collisionStay.empty()) {
+            return;
+        }
+        ++calls;
+        EXPECT_EQ(world.getStats().contactCount, static_cast<int>(world.getContacts().size()));
+        EXPECT_GT(world.getStats().stepTime, 0.0f);
+    });
+
+    scene.step(30);
+    EXPECT_GT(calls, 0);
+}
+
+namespace {
+
+// 用不同的线程数和分配顺序模拟同一个场景，逐段比较结果
+void expectSameSimulation(int threadCount, bool reverseAllocation) {
+    PhysicsScene expected;
+    expected.getWorld().setThreadCount(1);
+    expected.createPile(600, 7, 0.3f, false);
+
+    PhysicsScene actual;
+    actual.getWorld().setThreadCount(threadCount);
+    actual.createPile(600, 7, 0.3f, reverseAllocation);
+
+    for (int frame = 0; frame < 6; ++frame) {
+        expected.step(30);
+        actual.step(30);
+        SCOPED_TRACE(testing::Message() << "第 " << (frame + 1) * 30 << " 步");
+        expectSameBodies(expected, actual);
+        if (testing::Test::HasFatalFailure()) {
+            return;
+        }
+    }
+    EXPECT_GT(expected.getWorld().getStats().contactCount, 0);
+}
+
+} // namespace
+
+TEST(PhysicsWorldTest, ResultsIndependentOfThreadCount) {
+    expectSameSimulation(4, false);
+}
+
+TEST(PhysicsWorldTest, ResultsIndependentOfColliderAddresses) {
+    // 碰撞体地址的先后与登记顺序相反，求解顺序只取决于登记顺序
+    expectSameSimulation(1, true);
+}
+
+TEST(PhysicsWorldTest, RestoreThenReplayReproducesState) {
+    PhysicsScene scene;
+    scene.createPile(150, 11, 0.0f, false);
+    PhysicsWorld& world = scene.getWorld();
+    const std::vector<Rigidbody*>& bodies = scene.getBodies();
+
+    // 先让堆叠稳定，保存时一部分刚体已经休眠，热启动缓存中有累积冲量
+    scene.step(400);
+    PhysicsSnapshot saved;
+    world.saveState(saved);
+    int asleep = 0;
+    for (uint8_t flag : saved.asleep) {
+        asleep += flag;
+    }
+    ASSERT_GT(asleep, 0);
+    ASSERT_FALSE(saved.manifolds.empty());
+
+    // 两条时间线施加相同的冲量，其中一个刚体位于休眠岛中
+    const size_t sleeper = std::find(saved.asleep.begin(), saved.asleep.end(), 1) - saved.asleep.begin();
+    auto disturb = [&]() {
+        bodies[sleeper]->applyImpulse(Vector2(0.0f, -20000.0f));
+        bodies[bodies.size() / 2]->applyImpulse(Vector2(15000.0f, 0.0f));
+    };
+
+    disturb();
+    scene.step(90);
+    PhysicsSnapshot first;
+    world.saveState(first);
+
+    ASSERT_TRUE(world.restoreState(saved));
+    PhysicsSnapshot restored;
+    world.saveState(restored);
+    {
+        SCOPED_TRACE("恢复之后");
+        expectSameSnapshot(saved, restored);
+    }
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        ASSERT_EQ(bodies[i]->isAsleep(), saved.asleep[i] != 0) << "刚体 " << i;
+    }
+
+    disturb();
+    scene.step(90);
+    PhysicsSnapshot second;
+    world.saveState(second);
+    {
+        SCOPED_TRACE("重新模拟之后");
+        expectSameSnapshot(first, second);
+    }
+}
+
+TEST(PhysicsWorldTest, RestoreRejectsDifferentBodySet) {
+    PhysicsScene scene;
+    scene.createPile(30, 3, 0.0f, false);
+    PhysicsSnapshot saved;
+    scene.getWorld().saveState(saved);
+
+    scene.createDynamicBox(Vector2(0.0f, -500.0f), 10.0f);
+    EXPECT_FALSE(scene.getWorld().restoreState(saved));
+}
+
+TEST(PhysicsWorldTest, LayerCullCountsDynamicAndStaticPairs) {
+    // 第1层的动态方块同时压在第0层和第2层的静态方块上，并与第3层的动态方块重叠；
+    // 第1层与第2、3层不碰撞
+    PhysicsScene scene;
+    PhysicsWorld& world = scene.getWorld();
+    world.setGravity(Vector2(0.0f, 0.0f));
+    world.setLayerCollision(1, 2, false);
+    world.setLayerCollision(1, 3, false);
+
+    scene.createStaticBox(Vector2(0.0f, 20.0f), 100.0f, 20.0f);
+    Collider* culledStatic = scene.createStaticBox(Vector2(0.0f, -20.0f), 100.0f, 20.0f);
+    culledStatic->setLayer(2);
+    world.updateCollider(culledStatic);
+
+    Collider* player = scene.createDynamicBox(Vector2(0.0f, 0.0f), 30.0f)->getGameObject()->getComponent<BoxCollider>();
+    player->setLayer(1);
+    Collider* other = scene.createDynamicBox(Vector2(10.0f, 0.0f), 30.0f)->getGameObject()->getComponent<BoxCollider>();
+    other->setLayer(3);
+
+    scene.step(1);
+    // 保留的碰撞对：player-第0层地面、other-第0层地面、other-第2层静态方块
+    EXPECT_EQ(world.getStats().pairCount, 3);
+    EXPECT_EQ(world.getStats().layerCulledPairs, 2);
+
+    // 关闭性能记录后不再查询被屏蔽的静态桶，只统计动态碰撞对
+    world.setProfilingEnabled(false);
+    scene.step(1);
+    EXPECT_EQ(world.getStats().pairCount, 3);
+    EXPECT_EQ(world.getStats().layerCulledPairs, 1);
+}
+
+TEST(PhysicsWorldTest, RaycastBatchMatchesSingleRaycast) {
+    // 散布在大范围内的静态与动态方块，射线长短不一、分布在整个场景中，部分射线屏蔽第1层
+    PhysicsScene scene;
+    PhysicsWorld& world = scene.getWorld();
+    std::mt19937 random(5);
+    std::uniform_real_distribution<float> coordinate(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> size(10.0f, 80.0f);
+    std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+    for (int i = 0; i < 300; ++i) {
+        Collider* collider = scene.createStaticBox(Vector2(coordinate(random), coordinate(random)), size(random), size(random));
+        if (i % 3 == 0) {
+            collider->setLayer(1);
+            world.updateCollider(collider);
+        }
+    }
+    for (int i = 0; i < 300; ++i) {
+        Rigidbody* body = scene.createDynamicBox(Vector2(coordinate(random), coordinate(random)), size(random), angle(random));
+        if (i % 3 == 0) {
+            body->getGameObject()->getComponent<BoxCollider>()->setLayer(1);
+        }
+    }
+    world.syncTransforms();
+
+    std::uniform_real_distribution<float> length(10.0f, 1500.0f);
+    std::vector<Ray> rays;
+    for (int i = 0; i < 1000; ++i) {
+        const float direction = angle(random);
+        const uint32_t layerMask = i % 2 == 0 ? 0xFFFFFFFFu : ~2u;
+        rays.emplace_back(Vector2(coordinate(random), coordinate(random)),
+                          Vector2(std::cos(direction), std::sin(direction)), length(random), layerMask);
+    }
+
+    std::vector<RaycastHit> closest;
+    const int closestCount = world.raycastBatch(rays, closest, RaycastMode::CLOSEST);
+    std::vector<RaycastHit> all;
+    const int allCount = world.raycastBatch(rays, all, RaycastMode::ALL);
+    ASSERT_EQ(closest.size(), rays.size());
+    ASSERT_EQ(static_cast<int>(all.size()), allCount);
+
+    int expectedCount = 0;
+    size_t next = 0;
+    for (size_t r = 0; r < rays.size(); ++r) {
+        const Ray& ray = rays[r];
+        ASSERT_EQ(closest[r].rayIndex, static_cast<int>(r));
+
+        // 单条射线检测不支持层掩码，屏蔽第1层的射线只检查命中结果的层
+        CollisionInfo info;
+        const bool hit = world.raycast(ray.origin, ray.direction, ray.maxDistance, info);
+        if (ray.layerMask == 0xFFFFFFFFu) {
+            ASSERT_EQ(closest[r].collider != nullptr, hit) << "射线 " << r;
+            if (hit) {
+                EXPECT_NEAR(closest[r].distance, info.penetration, 1e-2f) << "射线 " << r;
+            }
+        } else if (closest[r].collider) {
+            EXPECT_NE(closest[r].collider->getLayer(), 1) << "射线 " << r;
+        }
+        expectedCount += closest[r].collider ? 1 : 0;
+
+        // ALL模式按射线顺序排列，同一射线由近到远，最近的一个与CLOSEST模式相同
+        const size_t first = next;
+        while (next < all.size() && all[next].rayIndex == static_cast<int>(r)) {
+            if (next > first) {
+                EXPECT_LE(all[next - 1].distance, all[next].distance) << "射线 " << r;
+            }
+            ++next;
+        }
+        ASSERT_EQ(next > first, closest[r].collider != nullptr) << "射线 " << r;
+        if (next > first) {
+            EXPECT_EQ(all[first].distance, closest[r].distance) << "射线 " << r;
+        }
+    }
+    EXPECT_EQ(next, all.size());
+    EXPECT_EQ(closestCount, expectedCount);
+}
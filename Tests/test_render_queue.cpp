@@ -0,0 +1,131 @@
+// RenderQueue排序测试：基数排序的结果与std::stable_sort一致
+
+#include "Engine2D/Graphics/RenderQueue.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Engine2D;
+
+namespace {
+
+// 用x字段记录提交顺序，排序后据此检查稳定性
+RenderCommand makeCommand(uint64_t key, size_t order) {
+    RenderCommand command = {};
+    command.sortKey = key;
+    command.x = static_cast<float>(order);
+    return command;
+}
+
+// 把keys提交到队列并排序，结果与std::stable_sort逐条比较
+void expectMatchesStableSort(const std::vector<uint64_t>& keys) {
+    RenderQueue queue;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        queue.submit(makeCommand(keys[i], i));
+    }
+    queue.sort();
+
+    std::vector<size_t> expected(keys.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        expected[i] = i;
+    }
+    std::stable_sort(expected.begin(), expected.end(), [&](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+    ASSERT_EQ(queue.getCount(), keys.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        const RenderCommand& command = queue.getSorted(i);
+        ASSERT_EQ(command.sortKey, keys[expected[i]]) << "位置 " << i;
+        ASSERT_EQ(static_cast<size_t>(command.x), expected[i]) << "位置 " << i;
+    }
+}
+
+} // namespace
+
+TEST(RenderQueueTest, RandomKeysMatchStableSort) {
+    std::mt19937_64 random(12345);
+    std::vector<uint64_t> keys(50000);
+    for (uint64_t& key : keys) {
+        key = random();
+    }
+    expectMatchesStableSort(keys);
+}
+
+TEST(RenderQueueTest, DuplicateKeysKeepSubmitOrder) {
+    // 少量不同的键，大量重复，同时让多数字节在整批中相同以走跳过趟的分支
+    std::mt19937 random(678);
+    std::uniform_int_distribution<int> layer(-3, 3);
+    std::uniform_int_distribution<int> depth(0, 4);
+    std::uniform_int_distribution<int> texture(1, 6);
+    std::vector<uint64_t> keys(50000);
+    for (uint64_t& key : keys) {
+        key = RenderCommand::makeSortKey(layer(random), static_cast<float>(depth(random)), SDL_BLENDMODE_BLEND,
+                                         reinterpret_cast<SDL_Texture*>(static_cast<uintptr_t>(texture(random) * 64)));
+    }
+    expectMatchesStableSort(keys);
+}
+
+TEST(RenderQueueTest, AllKeysEqual) {
+    expectMatchesStableSort(std::vector<uint64_t>(1000, 0x0123456789abcdefull));
+}
+
+TEST(RenderQueueTest, EmptyAndSingle) {
+    expectMatchesStableSort({});
+    expectMatchesStableSort({42});
+}
+
+TEST(RenderQueueTest, BulkSubmitMatchesSingleSubmit) {
+    std::mt19937_64 random(9);
+    std::vector<RenderCommand> commands;
+    std::vector<uint64_t> keys;
+    for (size_t i = 0; i < 4096; ++i) {
+        keys.push_back(random() & 0xff00ff00ull);
+        commands.push_back(makeCommand(keys.back(), i));
+    }
+
+    RenderQueue single;
+    for (const RenderCommand& command : commands) {
+        single.submit(command);
+    }
+    single.sort();
+
+    RenderQueue bulk;
+    bulk.submit(commands.data(), 1000);
+    bulk.submit(commands.data() + 1000, commands.size() - 1000);
+    bulk.sort();
+
+    ASSERT_EQ(bulk.getCount(), single.getCount());
+    for (size_t i = 0; i < commands.size(); ++i) {
+        EXPECT_EQ(bulk.getSorted(i).sortKey, single.getSorted(i).sortKey);
+        EXPECT_EQ(bulk.getSorted(i).x, single.getSorted(i).x);
+    }
+}
+
+TEST(RenderQueueTest, ClearThenReuse) {
+    RenderQueue queue;
+    queue.submit(makeCommand(5, 0));
+    queue.sort();
+    queue.clear();
+    EXPECT_EQ(queue.getCount(), 0u);
+
+    const uint64_t keys[] = { 3, 1, 2, 1 };
+    for (size_t i = 0; i < 4; ++i) {
+        queue.submit(makeCommand(keys[i], i));
+    }
+    queue.sort();
+    ASSERT_EQ(queue.getCount(), 4u);
+    EXPECT_EQ(queue.getSorted(0).x, 1.0f);
+    EXPECT_EQ(queue.getSorted(1).x, 3.0f);
+    EXPECT_EQ(queue.getSorted(2).x, 2.0f);
+    EXPECT_EQ(queue.getSorted(3).x, 0.0f);
+}
+
+TEST(RenderQueueTest, SortKeyOrdersLayerBeforeDepth) {
+    SDL_Texture* texture = reinterpret_cast<SDL_Texture*>(static_cast<uintptr_t>(0x1000));
+    EXPECT_LT(RenderCommand::makeSortKey(-1, 100.0f, SDL_BLENDMODE_BLEND, texture),
+              RenderCommand::makeSortKey(0, -100.0f, SDL_BLENDMODE_BLEND, texture));
+    EXPECT_LT(RenderCommand::makeSortKey(0, -1.0f, SDL_BLENDMODE_BLEND, texture),
+              RenderCommand::makeSortKey(0, 1.0f, SDL_BLENDMODE_BLEND, texture));
+    EXPECT_LT(RenderCommand::makeSortKey(0, 0.5f, SDL_BLENDMODE_BLEND, texture),
+              RenderCommand::makeSortKey(0, 2.0f, SDL_BLENDMODE_BLEND, texture));
+}
@@ -0,0 +1,119 @@
+// TilemapCollider合并测试：合并后的矩形恰好覆盖所有实心格子，互不重叠
+
+#include "Engine2D/Physics/Collider.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace Engine2D;
+
+namespace {
+
+// 逐格统计矩形覆盖次数：实心格子恰好覆盖一次，空格子不被覆盖
+void expectExactCover(const TilemapCollider& map, const std::vector<uint8_t>& tiles) {
+    const int width = map.getWidth();
+    const int height = map.getHeight();
+    std::vector<int> coverage(static_cast<size_t>(width) * height, 0);
+
+    for (int i = 0; i < map.getRectCount(); ++i) {
+        const TilemapCollider::TileRect& rect = map.getRect(i);
+        ASSERT_GT(rect.width, 0) << "矩形 " << i;
+        ASSERT_GT(rect.height, 0) << "矩形 " << i;
+        ASSERT_GE(rect.x, 0) << "矩形 " << i;
+        ASSERT_GE(rect.y, 0) << "矩形 " << i;
+        ASSERT_LE(rect.x + rect.width, width) << "矩形 " << i;
+        ASSERT_LE(rect.y + rect.height, height) << "矩形 " << i;
+        for (int y = rect.y; y < rect.y + rect.height; ++y) {
+            for (int x = rect.x; x < rect.x + rect.width; ++x) {
+                ++coverage[y * width + x];
+            }
+        }
+    }
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const int expected = tiles[y * width + x] ? 1 : 0;
+            ASSERT_EQ(coverage[y * width + x], expected) << "格子 (" << x << ", " << y << ")";
+        }
+    }
+}
+
+} // namespace
+
+TEST(TilemapColliderTest, EmptyMapHasNoRects) {
+    TilemapCollider map(0, 0, 16.0f);
+    map.setTiles(32, 16, std::vector<uint8_t>(32 * 16, 0));
+    EXPECT_EQ(map.getRectCount(), 0);
+}
+
+TEST(TilemapColliderTest, FullMapMergesToOneRect) {
+    TilemapCollider map(0, 0, 16.0f);
+    map.setTiles(32, 16, std::vector<uint8_t>(32 * 16, 1));
+    ASSERT_EQ(map.getRectCount(), 1);
+    EXPECT_EQ(map.getRect(0).x, 0);
+    EXPECT_EQ(map.getRect(0).y, 0);
+    EXPECT_EQ(map.getRect(0).width, 32);
+    EXPECT_EQ(map.getRect(0).height, 16);
+}
+
+TEST(TilemapColliderTest, CheckerboardCannotMerge) {
+    const int width = 9;
+    const int height = 7;
+    std::vector<uint8_t> tiles(width * height);
+    int solid = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            tiles[y * width + x] = (x + y) % 2 == 0;
+            solid += tiles[y * width + x];
+        }
+    }
+
+    TilemapCollider map(0, 0, 16.0f);
+    map.setTiles(width, height, tiles);
+    EXPECT_EQ(map.getRectCount(), solid);
+    expectExactCover(map, tiles);
+}
+
+TEST(TilemapColliderTest, RandomMapsAreCoveredExactly) {
+    std::mt19937 random(2024);
+    const float densities[] = { 0.1f, 0.5f, 0.9f };
+    for (float density : densities) {
+        std::bernoulli_distribution solid(density);
+        for (int round = 0; round < 20; ++round) {
+            const int width = 1 + static_cast<int>(random() % 64);
+            const int height = 1 + static_cast<int>(random() % 64);
+            std::vector<uint8_t> tiles(static_cast<size_t>(width) * height);
+            for (uint8_t& tile : tiles) {
+                tile = solid(random) ? 1 : 0;
+            }
+
+            TilemapCollider map(0, 0, 16.0f);
+            map.setTiles(width, height, tiles);
+            SCOPED_TRACE(testing::Message() << width << "x" << height << " 密度 " << density);
+            expectExactCover(map, tiles);
+        }
+    }
+}
+
+TEST(TilemapColliderTest, SetTileThenRebuild) {
+    const int width = 20;
+    const int height = 10;
+    std::vector<uint8_t> tiles(width * height, 1);
+
+    TilemapCollider map(0, 0, 16.0f);
+    map.setTiles(width, height, tiles);
+    ASSERT_EQ(map.getRectCount(), 1);
+
+    // 挖掉中间一格后整块必须拆开
+    map.setTile(10, 5, false);
+    tiles[5 * width + 10] = 0;
+    map.rebuild();
+    EXPECT_GT(map.getRectCount(), 1);
+    expectExactCover(map, tiles);
+
+    // 越界写入被忽略
+    map.setTile(-1, 0, true);
+    map.setTile(width, height, true);
+    map.rebuild();
+    expectExactCover(map, tiles);
+}